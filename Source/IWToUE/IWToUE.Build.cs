@@ -60,7 +60,10 @@ public class IWToUE : ModuleRules
 				"ToolWidgets",
 				"ApplicationCore",
 				"MessageLog",
-				"HTTP"
+				"HTTP",
+				"ImageCore",
+				"ImageWrapper",
+				"ContentBrowser"
 			}
 		);
 
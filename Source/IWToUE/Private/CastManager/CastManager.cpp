@@ -4,8 +4,296 @@
 #include "CastManager/CastModel.h"
 #include "CastManager/CastNode.h"
 #include "CastManager/CastRoot.h"
+#include "CastManager/CastStreamReader.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
 #include "Serialization/LargeMemoryReader.h"
-#include "Utils/BinaryReader.h"
+#include "SeLogChannels.h"
+
+namespace CastScan
+{
+	constexpr int64 NodeHeaderSize = sizeof(uint32) * 4 + sizeof(uint64);
+
+	bool ReadNodeHeader(FArchive& Ar, int64 Offset, int64 FileSize, FCastNodeHeader& Header)
+	{
+		Ar.Seek(Offset);
+		Ar << Header.Identifier;
+		Ar << Header.NodeSize;
+		Ar << Header.NodeHash;
+		Ar << Header.PropertyCount;
+		Ar << Header.ChildCount;
+		return !Ar.IsError() && Header.NodeSize >= NodeHeaderSize && Offset + Header.NodeSize <= FileSize;
+	}
+
+	uint32 ReadIndexValue(FArchive& Ar, ECastPropertyId DataType)
+	{
+		switch (DataType)
+		{
+		case ECastPropertyId::Byte:
+			{
+				uint8 Value = 0;
+				Ar << Value;
+				return Value;
+			}
+		case ECastPropertyId::Short:
+			{
+				uint16 Value = 0;
+				Ar << Value;
+				return Value;
+			}
+		case ECastPropertyId::Integer32:
+			{
+				uint32 Value = 0;
+				Ar << Value;
+				return Value;
+			}
+		default: return 0;
+		}
+	}
+
+	// 逐个读取属性头，回调可以读取数据，之后跳到下一个属性
+	bool ScanProperties(FArchive& Ar, uint32 PropertyCount,
+	                    TFunctionRef<void(uint32 NameId, ECastPropertyId DataType, FArchive& Ar)> Visitor)
+	{
+		for (uint32 i = 0; i < PropertyCount; ++i)
+		{
+			uint16 Identifier;
+			uint16 NameSize;
+			uint32 ArrayLength;
+			Ar << Identifier;
+			Ar << NameSize;
+			Ar << ArrayLength;
+
+			// 这里只关心短名称，过长的名称截断后不会与任何关心的 id 相等
+			ANSICHAR Name[64];
+			const uint32 ReadSize = FMath::Min<uint32>(NameSize, UE_ARRAY_COUNT(Name));
+			Ar.Serialize(Name, ReadSize);
+			Ar.Seek(Ar.Tell() + (NameSize - ReadSize));
+			if (Ar.IsError()) return false;
+
+			const ECastPropertyId DataType = Identifier
+				                                 ? static_cast<ECastPropertyId>(Identifier)
+				                                 : ECastPropertyId::String;
+			const int64 DataOffset = Ar.Tell();
+			Visitor(CastPropertyNameId(Name, ReadSize), DataType, Ar);
+
+			Ar.Seek(DataOffset);
+			if (DataType == ECastPropertyId::String)
+			{
+				ANSICHAR Char = 1;
+				while (Char != 0 && !Ar.AtEnd())
+				{
+					Ar << Char;
+				}
+			}
+			else
+			{
+				Ar.Seek(DataOffset + static_cast<int64>(FCastNodeProperty::GetElementSize(DataType)) * ArrayLength);
+			}
+			if (Ar.IsError()) return false;
+		}
+		return true;
+	}
+
+	bool SkipProperties(FArchive& Ar, uint32 PropertyCount)
+	{
+		return ScanProperties(Ar, PropertyCount, [](uint32, ECastPropertyId, FArchive&)
+		{
+		});
+	}
+
+	bool ScanModel(FArchive& Ar, const FCastNodeHeader& ModelHeader, int64 ModelOffset, int64 FileSize,
+	               FCastSceneInfo& OutInfo)
+	{
+		Ar.Seek(ModelOffset + NodeHeaderSize);
+		if (!SkipProperties(Ar, ModelHeader.PropertyCount)) return false;
+
+		bool bFirstMesh = true;
+		int64 ChildOffset = Ar.Tell();
+		for (uint32 i = 0; i < ModelHeader.ChildCount; ++i)
+		{
+			FCastNodeHeader ChildHeader;
+			if (!ReadNodeHeader(Ar, ChildOffset, FileSize, ChildHeader)) return false;
+
+			switch (ChildHeader.Identifier)
+			{
+			case 0x6873656D: // Mesh
+				{
+					++OutInfo.TotalGeometryNum;
+					// 与 FCastScene::GetSkinnedMeshNum 一致，只看模型的第一个网格
+					if (bFirstMesh)
+					{
+						bFirstMesh = false;
+						uint32 MaxWeight = 0;
+						if (!ScanProperties(Ar, ChildHeader.PropertyCount,
+						                    [&MaxWeight](uint32 NameId, ECastPropertyId DataType, FArchive& PropAr)
+						                    {
+							                    if (NameId == CastPropertyNameId("mi"))
+							                    {
+								                    MaxWeight = ReadIndexValue(PropAr, DataType);
+							                    }
+						                    }))
+						{
+							return false;
+						}
+						OutInfo.SkinnedMeshNum += MaxWeight > 0;
+					}
+					break;
+				}
+			case 0x6C74616D: // Material
+				++OutInfo.TotalMaterialNum;
+				// 每个 File 子节点对应一张贴图
+				OutInfo.TotalTextureNum += ChildHeader.ChildCount;
+				break;
+			default: break;
+			}
+			ChildOffset += ChildHeader.NodeSize;
+		}
+		return true;
+	}
+
+	bool ScanAnimation(FArchive& Ar, const FCastNodeHeader& AnimHeader, int64 AnimOffset, int64 FileSize,
+	                   FCastSceneInfo& OutInfo)
+	{
+		Ar.Seek(AnimOffset + NodeHeaderSize);
+		float Framerate = 0.f;
+		if (!ScanProperties(Ar, AnimHeader.PropertyCount,
+		                    [&Framerate](uint32 NameId, ECastPropertyId DataType, FArchive& PropAr)
+		                    {
+			                    if (NameId == CastPropertyNameId("f") && DataType == ECastPropertyId::Float)
+			                    {
+				                    PropAr << Framerate;
+			                    }
+		                    }))
+		{
+			return false;
+		}
+
+		int64 ChildOffset = Ar.Tell();
+		for (uint32 i = 0; i < AnimHeader.ChildCount; ++i)
+		{
+			FCastNodeHeader ChildHeader;
+			if (!ReadNodeHeader(Ar, ChildOffset, FileSize, ChildHeader)) return false;
+			if (ChildHeader.Identifier == 0x76727563) // Curve
+			{
+				// 与 FCastScene::GetAnimFramerate 一致，取第一个有曲线的动画
+				if (!OutInfo.bHasAnimation)
+				{
+					OutInfo.FrameRate = Framerate;
+				}
+				OutInfo.bHasAnimation = true;
+				break;
+			}
+			ChildOffset += ChildHeader.NodeSize;
+		}
+		return true;
+	}
+}
+
+bool FCastManager::ScanFile(const FString& InFilePath, FCastSceneInfo& OutInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastManager::ScanFile);
+
+	OutInfo.Reset();
+
+	const TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*InFilePath));
+	if (!Ar) return false;
+
+	FCastHeader Header;
+	*Ar << Header.Magic;
+	*Ar << Header.Version;
+	*Ar << Header.RootNodes;
+	*Ar << Header.Flags;
+	if (Ar->IsError() || Header.Magic != 0x74736163) return false;
+
+	const int64 FileSize = Ar->TotalSize();
+	int64 NodeOffset = Ar->Tell();
+	for (uint32 i = 0; i < Header.RootNodes; ++i)
+	{
+		FCastNodeHeader RootHeader;
+		if (!CastScan::ReadNodeHeader(*Ar, NodeOffset, FileSize, RootHeader)) return false;
+
+		if (RootHeader.Identifier == 0x746F6F72) // Root
+		{
+			if (!CastScan::SkipProperties(*Ar, RootHeader.PropertyCount)) return false;
+
+			int64 ChildOffset = Ar->Tell();
+			for (uint32 k = 0; k < RootHeader.ChildCount; ++k)
+			{
+				FCastNodeHeader ChildHeader;
+				if (!CastScan::ReadNodeHeader(*Ar, ChildOffset, FileSize, ChildHeader)) return false;
+
+				bool bChildOk = true;
+				if (ChildHeader.Identifier == 0x6C646F6D) // Model
+				{
+					bChildOk = CastScan::ScanModel(*Ar, ChildHeader, ChildOffset, FileSize, OutInfo);
+				}
+				else if (ChildHeader.Identifier == 0x6D696E61) // Animation
+				{
+					bChildOk = CastScan::ScanAnimation(*Ar, ChildHeader, ChildOffset, FileSize, OutInfo);
+				}
+				if (!bChildOk) return false;
+				ChildOffset += ChildHeader.NodeSize;
+			}
+		}
+		NodeOffset += RootHeader.NodeSize;
+	}
+	return true;
+}
+
+namespace
+{
+	// 将流式读取的动画写入 FCastAnimationInfo
+	class FCastAnimationBuilder final : public ICastAnimationVisitor
+	{
+	public:
+		explicit FCastAnimationBuilder(TArray<FCastAnimationInfo>& InAnimations)
+			: Animations(InAnimations)
+		{
+		}
+
+		virtual void BeginAnimation(const FString& Name, float Framerate, bool bLooping) override
+		{
+			Animation = &Animations.AddDefaulted_GetRef();
+			Animation->Name = Name;
+			Animation->Framerate = Framerate;
+			Animation->Looping = bLooping;
+		}
+
+		virtual void OnCurve(const FCastCurveView& CurveView) override
+		{
+			FCastCurveInfo& Curve = Animation->Curves.AddDefaulted_GetRef();
+			Curve.NodeName = CurveView.NodeName;
+			Curve.KeyPropertyName = CurveView.KeyPropertyName;
+			Curve.Mode = CurveView.Mode;
+			Curve.AdditiveBlendWeight = CurveView.AdditiveBlendWeight;
+			Curve.KeyFrameBuffer.Append(CurveView.KeyFrames.GetData(), CurveView.KeyFrames.Num());
+			Curve.FloatValueBuffer.Append(CurveView.FloatValues.GetData(), CurveView.FloatValues.Num());
+			Curve.QuatValueBuffer.Append(CurveView.QuatValues.GetData(), CurveView.QuatValues.Num());
+		}
+
+		virtual void OnCurveModeOverride(const FCastCurveModeOverrideInfo& CurveModeOverride) override
+		{
+			Animation->CurveModeOverrides.Add(CurveModeOverride);
+		}
+
+		virtual void OnNotificationTrack(const FString& Name, TArrayView<const uint32> KeyFrames) override
+		{
+			FCastNotificationTrackInfo& NotificationTrack = Animation->NotificationTracks.AddDefaulted_GetRef();
+			NotificationTrack.Name = Name;
+			NotificationTrack.KeyFrameBuffer.Append(KeyFrames.GetData(), KeyFrames.Num());
+		}
+
+		virtual void EndAnimation() override
+		{
+			Animation = nullptr;
+		}
+
+	private:
+		TArray<FCastAnimationInfo>& Animations;
+		FCastAnimationInfo* Animation{nullptr};
+	};
+}
 
 FCastManager::~FCastManager()
 {
@@ -14,20 +302,66 @@ FCastManager::~FCastManager()
 
 bool FCastManager::Initialize(FString InFilePath)
 {
+	ReleaseFile();
 	FilePath = InFilePath;
-	if (!FFileHelper::LoadFileToArray(FileDataOld, *FilePath))
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (MappedFile.IsValid())
 	{
-		return false;
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
 	}
-	Reader = MakeUnique<FLargeMemoryReader>(FileDataOld.GetData(), FileDataOld.Num());
+
+	if (MappedRegion.IsValid())
+	{
+		FileData = MappedRegion->GetMappedPtr();
+		FileSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(FileDataOld, *FilePath))
+		{
+			return false;
+		}
+		FileData = FileDataOld.GetData();
+		FileSize = FileDataOld.Num();
+	}
+	Reader = MakeUnique<FLargeMemoryReader>(FileData, FileSize);
+
+	return true;
+}
+
+bool FCastManager::Initialize(TArray64<uint8>&& InFileData, FString InFilePath)
+{
+	ReleaseFile();
+	FilePath = InFilePath;
+
+	FileDataOld = MoveTemp(InFileData);
+	FileData = FileDataOld.GetData();
+	FileSize = FileDataOld.Num();
+	Reader = MakeUnique<FLargeMemoryReader>(FileData, FileSize);
 
 	return true;
 }
 
+void FCastManager::ReleaseFile()
+{
+	// 属性视图指向映射内存，必须先释放场景
+	if (Scene.IsValid()) Scene.Reset();
+	if (Reader.IsValid()) Reader.Reset();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FileDataOld.Empty();
+	FileData = nullptr;
+	FileSize = 0;
+}
+
 bool FCastManager::Import()
 {
 	Scene = MakeUnique<FCastScene>();
 	if (!Scene) return false;
+	Scene->SetArena(FileData, FileSize);
 
 	auto& [Magic, Version, RootNodes, Flags] = Scene->Header;
 	Reader->ByteOrderSerialize(&Magic, sizeof(Magic));
@@ -37,30 +371,127 @@ bool FCastManager::Import()
 
 	if (Magic != 0x74736163) return false;
 
-	Scene->RootNodes.Empty();
-	for (uint32 i = 0; i < RootNodes; ++i)
+	// 第一遍：借助 NodeSize 跳过数据，只记录每棵子树的位置
+	TArray<FCastSubtree> Subtrees;
+	if (!IndexSubtrees(Subtrees))
+	{
+		UE_LOG(LogCast, Error, TEXT("Cast file '%s' is truncated or malformed"), *FilePath);
+		return false;
+	}
+
+	// 第二遍：子树之间没有引用关系，并行解码到各自的 FCastRoot 片段
+	TArray<FCastRoot> Fragments;
+	Fragments.SetNum(Subtrees.Num());
+	TArray<int32> FragmentNodeCounts;
+	FragmentNodeCounts.SetNumZeroed(Subtrees.Num());
+	std::atomic<bool> bDecodeError{false};
+
+	ParallelFor(Subtrees.Num(), [&](int32 Index)
+	{
+		// 动画直接流式读取到类型化的缓冲，不构建节点树
+		if (Subtrees[Index].Identifier == 0x6D696E61) // Animation
+		{
+			FCastAnimationBuilder Builder(Fragments[Index].Animations);
+			FCastStreamReader StreamReader(*Scene);
+			if (!StreamReader.ReadAnimation(Subtrees[Index].Offset, Builder))
+			{
+				bDecodeError = true;
+			}
+			return;
+		}
+
+		FLargeMemoryReader SubtreeReader(FileData, FileSize);
+		SubtreeReader.Seek(Subtrees[Index].Offset);
+
+		FCastNodeTree Tree;
+		const int32 NodeIdx = ReadNode(SubtreeReader, Tree);
+		if (SubtreeReader.IsError())
+		{
+			bDecodeError = true;
+			return;
+		}
+		ProcessRootData(Tree, Tree.Nodes[NodeIdx], Fragments[Index]);
+		FragmentNodeCounts[Index] = Tree.Nodes.Num();
+	}, EParallelForFlags::Unbalanced);
+
+	if (bDecodeError)
 	{
-		Scene->RootNodes.Add(GetNode());
+		UE_LOG(LogCast, Error, TEXT("Cast file '%s' is truncated or malformed"), *FilePath);
+		return false;
 	}
 
-	for (int32 Idx : Scene->RootNodes)
+	// 按文件顺序合并
+	for (int32 Index = 0; Index < Subtrees.Num(); ++Index)
 	{
-		ProcessCastData(Scene->Nodes[Idx]);
+		FCastRoot& Root = Scene->Roots[Subtrees[Index].RootIndex];
+		FCastRoot& Fragment = Fragments[Index];
+		Root.Models.Append(MoveTemp(Fragment.Models));
+		Root.ModelLodInfo.Append(MoveTemp(Fragment.ModelLodInfo));
+		Root.Animations.Append(MoveTemp(Fragment.Animations));
+		Root.Instances.Append(MoveTemp(Fragment.Instances));
+		Root.Metadata.Append(MoveTemp(Fragment.Metadata));
+		Scene->NodeCount += FragmentNodeCounts[Index];
 	}
 
 	return true;
 }
 
+bool FCastManager::IndexSubtrees(TArray<FCastSubtree>& OutSubtrees)
+{
+	using CastScan::NodeHeaderSize;
+
+	int64 NodeOffset = Reader->Tell();
+	for (uint32 i = 0; i < Scene->Header.RootNodes; ++i)
+	{
+		FCastNodeHeader RootHeader;
+		Reader->Seek(NodeOffset);
+		*Reader << RootHeader.Identifier;
+		*Reader << RootHeader.NodeSize;
+		*Reader << RootHeader.NodeHash;
+		*Reader << RootHeader.PropertyCount;
+		*Reader << RootHeader.ChildCount;
+		if (Reader->IsError() || RootHeader.NodeSize < NodeHeaderSize || NodeOffset + RootHeader.NodeSize > FileSize)
+		{
+			return false;
+		}
+		++Scene->NodeCount;
+
+		if (RootHeader.Identifier == 0x746F6F72) // Root
+		{
+			const int32 RootIndex = Scene->Roots.AddDefaulted();
+
+			FCastNodeProperty Property;
+			for (uint32 j = 0; j < RootHeader.PropertyCount; ++j)
+			{
+				if (!ReadProperty(*Reader, Property)) return false;
+			}
+
+			int64 ChildOffset = Reader->Tell();
+			for (uint32 k = 0; k < RootHeader.ChildCount; ++k)
+			{
+				uint32 ChildIdentifier = 0;
+				uint32 ChildSize = 0;
+				Reader->Seek(ChildOffset);
+				*Reader << ChildIdentifier;
+				*Reader << ChildSize;
+				if (Reader->IsError() || ChildSize < NodeHeaderSize || ChildOffset + ChildSize > FileSize)
+				{
+					return false;
+				}
+				OutSubtrees.Add({RootIndex, ChildIdentifier, ChildOffset});
+				ChildOffset += ChildSize;
+			}
+		}
+		NodeOffset += RootHeader.NodeSize;
+	}
+	return true;
+}
+
 void FCastManager::Destroy()
 {
 	if (bWasDestroy) return;
 	bWasDestroy = true;
-	if (Scene.IsValid())
-	{
-		Scene.Reset();
-		Scene = nullptr;
-	}
-	if (Reader.IsValid()) Reader.Reset();
+	ReleaseFile();
 }
 
 int32 FCastManager::GetBoneNum() const
@@ -111,201 +542,87 @@ int32 FCastManager::GetFaceNum() const
 	return Res;
 }
 
-int32 FCastManager::GetNode()
+bool FCastManager::ReadProperty(FArchive& Ar, FCastNodeProperty& Property) const
 {
-	const int32 Idx = Scene->Nodes.Add(FCastNode());
-	FCastNodeHeader& NodeHeader = Scene->Nodes[Idx].Header;
-	TArray<FCastNodeProperty>& Properties = Scene->Nodes[Idx].Properties;
+	return FCastStreamReader::ReadProperty(Ar, FileData, FileSize, Property);
+}
+
+int32 FCastManager::ReadNode(FArchive& Ar, FCastNodeTree& Tree) const
+{
+	const int32 Idx = Tree.Nodes.Add(FCastNode());
+	FCastNodeHeader& NodeHeader = Tree.Nodes[Idx].Header;
 
-	*Reader << NodeHeader.Identifier;
-	*Reader << NodeHeader.NodeSize;
-	*Reader << NodeHeader.NodeHash;
-	*Reader << NodeHeader.PropertyCount;
-	*Reader << NodeHeader.ChildCount;
+	Ar << NodeHeader.Identifier;
+	Ar << NodeHeader.NodeSize;
+	Ar << NodeHeader.NodeHash;
+	Ar << NodeHeader.PropertyCount;
+	Ar << NodeHeader.ChildCount;
 
+	Tree.Nodes[Idx].FirstProperty = Tree.Properties.Num();
+	Tree.Properties.Reserve(Tree.Properties.Num() + NodeHeader.PropertyCount);
 	for (uint32 j = 0; j < NodeHeader.PropertyCount; ++j)
 	{
 		FCastNodeProperty Property;
-		*Reader << Property.Identifier;
-		*Reader << Property.NameSize;
-		*Reader << Property.ArrayLength;
-		const float ArrayLength = Property.ArrayLength;
-
-		for (uint32 k = 0; k < Property.NameSize; ++k)
-		{
-			ANSICHAR Tmp;
-			*Reader << Tmp;
-			Property.PropertyName.AppendChar(Tmp);
-		}
-
-		Property.DataType = Property.Identifier
-			                    ? static_cast<ECastPropertyId>(Property.Identifier)
-			                    : ECastPropertyId::String;
-
-		switch (Property.DataType)
+		if (!ReadProperty(Ar, Property))
 		{
-		case ECastPropertyId::Byte:
-			{
-				Property.ByteArray.SetNum(ArrayLength);
-				Reader->Serialize(Property.ByteArray.GetData(), Property.ArrayLength * sizeof(uint8));
-				break;
-			}
-		case ECastPropertyId::Short:
-			{
-				Property.ShortArray.SetNum(ArrayLength);
-				Reader->Serialize(Property.ShortArray.GetData(), Property.ArrayLength * sizeof(uint16));
-				break;
-			}
-		case ECastPropertyId::Integer32:
-			{
-				Property.IntArray.SetNum(ArrayLength);
-				Reader->Serialize(Property.IntArray.GetData(), ArrayLength * sizeof(int32));
-				break;
-			}
-		case ECastPropertyId::Integer64:
-			{
-				Property.Int64Array.SetNum(ArrayLength);
-				Reader->Serialize(Property.Int64Array.GetData(), ArrayLength * sizeof(int64));
-				break;
-			}
-		case ECastPropertyId::Float:
-			{
-				Property.FloatArray.SetNum(ArrayLength);
-				Reader->Serialize(Property.FloatArray.GetData(), ArrayLength * sizeof(float));
-				break;
-			}
-		case ECastPropertyId::Double:
-			{
-				Property.DoubleArray.SetNum(ArrayLength);
-				Reader->Serialize(Property.DoubleArray.GetData(), ArrayLength * sizeof(double));
-				break;
-			}
-		case ECastPropertyId::String:
-			{
-				FBinaryReader::ReadString(*Reader, &Property.StringData);
-				break;
-			}
-		case ECastPropertyId::Vector2:
-			{
-				Property.Vector2Array.SetNum(ArrayLength);
-				for (FVector2f& Vector : Property.Vector2Array) *Reader << Vector;
-				break;
-			}
-		case ECastPropertyId::Vector3:
-			{
-				Property.Vector3Array.SetNum(ArrayLength);
-				for (FVector3f& Vector : Property.Vector3Array) *Reader << Vector;
-				break;
-			}
-		case ECastPropertyId::Vector4:
-			{
-				Property.Vector4Array.SetNum(ArrayLength);
-				for (FVector4f& Vector : Property.Vector4Array) *Reader << Vector;
-				break;
-			}
-		default:
-			break;
+			return Idx;
 		}
-		Properties.Add(Property);
+		Tree.Properties.Add(Property);
 	}
 	const uint32 ChildNodeCount = NodeHeader.ChildCount;
 	for (uint32 k = 0; k < ChildNodeCount; ++k)
 	{
-		if (k >= ChildNodeCount) break;
-		int32 NewIdx = GetNode();
-		Scene->Nodes[Idx].ChildNodes.Add(NewIdx);
+		if (Ar.IsError()) break;
+		int32 NewIdx = ReadNode(Ar, Tree);
+		Tree.Nodes[Idx].ChildNodes.Add(NewIdx);
 	}
 	return Idx;
 }
 
-void FCastManager::ProcessCastData(FCastNode& Node)
-{
-	switch (Node.Header.Identifier)
-	{
-	case 0x746F6F72: // Root
-		{
-			FCastRoot Root;
-			for (uint32 Idx : Node.ChildNodes)
-			{
-				ProcessRootData(Scene->Nodes[Idx], Root);
-			}
-			Scene->Roots.Add(Root);
-			break;
-		}
-	default: break;
-	}
-}
-
-void FCastManager::ProcessRootData(FCastNode& Node, FCastRoot& Root)
+void FCastManager::ProcessRootData(const FCastNodeTree& Tree, const FCastNode& Node, FCastRoot& Root) const
 {
 	switch (Node.Header.Identifier)
 	{
 	case 0x6C646F6D: // Model
 		{
 			FCastModelInfo Model;
-			for (auto Property : Node.Properties)
-			{
-				if (Property.PropertyName == "n")
-				{
-					Model.Name = Property.PropertyName;
-				}
-			}
-			for (uint32 Idx : Node.ChildNodes)
-			{
-				ProcessModelData(Scene->Nodes[Idx], Model);
-			}
-			Root.Models.Add(Model);
-			break;
-		}
-	case 0x6D696E61: // Animation
-		{
-			FCastAnimationInfo Animation;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
+				if (Property.NameId == CastPropertyNameId("n"))
 				{
-					Animation.Name = Property.PropertyName;
-				}
-				else if (Property.PropertyName == "f")
-				{
-					Animation.Framerate = Property.FloatArray[0];
-				}
-				else if (Property.PropertyName == "b")
-				{
-					Animation.Looping = static_cast<bool>(Property.ByteArray[0]);
+					Model.Name = Scene->GetString(Property);
 				}
 			}
 			for (uint32 Idx : Node.ChildNodes)
 			{
-				ProcessAnimationData(Scene->Nodes[Idx], Animation);
+				ProcessModelData(Tree, Tree.Nodes[Idx], Model);
 			}
-			Root.Animations.Add(Animation);
+			Root.Models.Add(MoveTemp(Model));
 			break;
 		}
 	case 0x74736E69: // Instance
 		{
 			FCastInstanceInfo Instance;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					Instance.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "rf")
-				{
-					Instance.ReferenceFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "p")
-				{
-					Instance.Position = Property.Vector3Array[0];
-				}
-				else if (Property.PropertyName == "r")
-				{
-					Instance.Rotation = Property.Vector4Array[0];
-				}
-				else if (Property.PropertyName == "s")
-				{
-					Instance.Scale = Property.Vector3Array[0];
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					Instance.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("rf"):
+					Instance.ReferenceFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("p"):
+					Instance.Position = Scene->GetValue<FVector3f>(Property);
+					break;
+				case CastPropertyNameId("r"):
+					Instance.Rotation = Scene->GetValue<FVector4f>(Property);
+					break;
+				case CastPropertyNameId("s"):
+					Instance.Scale = Scene->GetValue<FVector3f>(Property);
+					break;
+				default: break;
 				}
 			}
 			Root.Instances.Add(Instance);
@@ -314,19 +631,20 @@ void FCastManager::ProcessRootData(FCastNode& Node, FCastRoot& Root)
 	case 0x6174656D: // Metadata
 		{
 			FCastMetadataInfo Metadata;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "p")
-				{
-					Metadata.Author = Property.StringData;
-				}
-				else if (Property.PropertyName == "s")
-				{
-					Metadata.Software = Property.StringData;
-				}
-				if (Property.PropertyName == "up")
-				{
-					Metadata.UpAxis = Property.StringData;
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("p"):
+					Metadata.Author = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("s"):
+					Metadata.Software = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("up"):
+					Metadata.UpAxis = Scene->GetString(Property);
+					break;
+				default: break;
 				}
 			}
 			Root.Metadata.Add(Metadata);
@@ -336,146 +654,115 @@ void FCastManager::ProcessRootData(FCastNode& Node, FCastRoot& Root)
 	}
 }
 
-void FCastManager::ProcessModelData(FCastNode& Node, FCastModelInfo& Model)
+void FCastManager::ProcessModelData(const FCastNodeTree& Tree, const FCastNode& Node, FCastModelInfo& Model) const
 {
 	switch (Node.Header.Identifier)
 	{
 	case 0x6873656D: // Mesh
 		{
 			FCastMeshInfo Mesh;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					Mesh.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "vp")
-				{
-					Mesh.VertexPositions = Property.Vector3Array;
-				}
-				else if (Property.PropertyName == "vn")
-				{
-					Mesh.VertexNormals = Property.Vector3Array;
-				}
-				else if (Property.PropertyName == "vt")
-				{
-					Mesh.VertexTangents = Property.Vector3Array;
-				}
-				else if (Property.PropertyName == "wb")
-				{
-					Mesh.VertexWeightBone.Empty();
-					if (Property.DataType == ECastPropertyId::Integer32)
-						COPY_ARR(Property.IntArray, Mesh.VertexWeightBone)
-					if (Property.DataType == ECastPropertyId::Short)
-						COPY_ARR(Property.ShortArray, Mesh.VertexWeightBone)
-					if (Property.DataType == ECastPropertyId::Byte)
-						COPY_ARR(Property.ByteArray, Mesh.VertexWeightBone)
-				}
-				else if (Property.PropertyName == "wv")
-				{
-					Mesh.VertexWeightValue = Property.FloatArray;
-				}
-				else if (Property.PropertyName == "f")
-				{
-					Mesh.Faces.Empty();
-					if (Property.DataType == ECastPropertyId::Integer32)
-						COPY_ARR(Property.IntArray, Mesh.Faces)
-					if (Property.DataType == ECastPropertyId::Short)
-						COPY_ARR(Property.ShortArray, Mesh.Faces)
-					if (Property.DataType == ECastPropertyId::Byte)
-						COPY_ARR(Property.ByteArray, Mesh.Faces)
-				}
-				else if (Property.PropertyName == "cl")
-				{
-					Mesh.ColorLayer.Empty();
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					Mesh.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("vp"):
+					Mesh.VertexPositions = Scene->GetSpan<FVector3f>(Property).ToArray();
+					break;
+				case CastPropertyNameId("vn"):
+					Mesh.VertexNormals = Scene->GetSpan<FVector3f>(Property).ToArray();
+					break;
+				case CastPropertyNameId("vt"):
+					Mesh.VertexTangents = Scene->GetSpan<FVector3f>(Property).ToArray();
+					break;
+				case CastPropertyNameId("wb"):
+					Scene->WidenArray(Property, Mesh.VertexWeightBone);
+					break;
+				case CastPropertyNameId("wv"):
+					Mesh.VertexWeightValue = Scene->GetSpan<float>(Property).ToArray();
+					break;
+				case CastPropertyNameId("f"):
+					Scene->WidenArray(Property, Mesh.Faces);
+					break;
+				case CastPropertyNameId("cl"):
+					Scene->WidenArray(Property, Mesh.ColorLayer);
+					break;
+				case CastPropertyNameId("ul"):
 					if (Property.DataType == ECastPropertyId::Integer32)
-						COPY_ARR(Property.IntArray, Mesh.ColorLayer)
+						Mesh.UVLayer = Scene->GetValue<uint32>(Property);
 					if (Property.DataType == ECastPropertyId::Short)
-						COPY_ARR(Property.ShortArray, Mesh.ColorLayer)
+						Mesh.UVLayer = Scene->GetValue<uint16>(Property);
 					if (Property.DataType == ECastPropertyId::Byte)
-						COPY_ARR(Property.ByteArray, Mesh.ColorLayer)
-				}
-				else if (Property.PropertyName == "ul")
-				{
-					if (Property.DataType == ECastPropertyId::Integer32)
-						Mesh.UVLayer = Property.IntArray[0];
-					if (Property.DataType == ECastPropertyId::Short)
-						Mesh.UVLayer = Property.ShortArray[0];
-					if (Property.DataType == ECastPropertyId::Byte)
-						Mesh.UVLayer = Property.ByteArray[0];
-				}
-				else if (Property.PropertyName == "mi")
-				{
+						Mesh.UVLayer = Scene->GetValue<uint8>(Property);
+					break;
+				case CastPropertyNameId("mi"):
 					if (Property.DataType == ECastPropertyId::Integer32)
-						Mesh.MaxWeight = Property.IntArray[0];
+						Mesh.MaxWeight = Scene->GetValue<uint32>(Property);
 					if (Property.DataType == ECastPropertyId::Short)
-						Mesh.MaxWeight = Property.ShortArray[0];
+						Mesh.MaxWeight = Scene->GetValue<uint16>(Property);
 					if (Property.DataType == ECastPropertyId::Byte)
-						Mesh.MaxWeight = Property.ByteArray[0];
-				}
-				else if (Property.PropertyName == "sm")
-				{
-					Mesh.SkinningMethod = Property.StringData;
-				}
-				else if (Property.PropertyName == "m")
-				{
-					Mesh.MaterialHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "vc")
-				{
+						Mesh.MaxWeight = Scene->GetValue<uint8>(Property);
+					break;
+				case CastPropertyNameId("sm"):
+					Mesh.SkinningMethod = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("m"):
+					Mesh.MaterialHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("vc"):
 					// if (Mesh.VertexColor.IsEmpty()) Mesh.VertexColor.Add(Property.IntArray);
-					Mesh.VertexColor = Property.IntArray;
-				}
-				else if (Property.PropertyName[0] == 'c')
-				{
-					// int32 ArrIdx = Property.PropertyName[1] - '0';
-					// if (Mesh.VertexColor.Num() <= ArrIdx) Mesh.VertexColor.SetNum(ArrIdx + 1);
-					// Mesh.VertexColor[ArrIdx] = Property.IntArray;
-					Mesh.VertexColor = Property.IntArray;
-				}
-				else if (Property.PropertyName[0] == 'u')
-				{
-					// int32 ArrIdx = Property.PropertyName[1] - '0';
-					// if (Mesh.VertexUV.Num() <= ArrIdx) Mesh.VertexUV.SetNum(ArrIdx + 1);
-					// Mesh.VertexUV[ArrIdx] = Property.Vector2Array;
-					Mesh.VertexUV = Property.Vector2Array;
+					Mesh.VertexColor = Scene->GetSpan<uint32>(Property).ToArray();
+					break;
+				default:
+					// 带层号的颜色/UV，如 "c0"、"u1"
+					if (CastPropertyNamePrefix(Property.NameId) == 'c')
+					{
+						// int32 ArrIdx = Property.PropertyName[1] - '0';
+						// if (Mesh.VertexColor.Num() <= ArrIdx) Mesh.VertexColor.SetNum(ArrIdx + 1);
+						// Mesh.VertexColor[ArrIdx] = Property.IntArray;
+						Mesh.VertexColor = Scene->GetSpan<uint32>(Property).ToArray();
+					}
+					else if (CastPropertyNamePrefix(Property.NameId) == 'u')
+					{
+						// int32 ArrIdx = Property.PropertyName[1] - '0';
+						// if (Mesh.VertexUV.Num() <= ArrIdx) Mesh.VertexUV.SetNum(ArrIdx + 1);
+						// Mesh.VertexUV[ArrIdx] = Property.Vector2Array;
+						Mesh.VertexUV = Scene->GetSpan<FVector2f>(Property).ToArray();
+					}
+					break;
 				}
 			}
-			Model.Meshes.Add(Mesh);
+			Model.Meshes.Add(MoveTemp(Mesh));
+			break;
 		}
 	case 0x68736C62: // BlendShape
 		{
 			FCastBlendShape BlendShape;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					BlendShape.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "b")
-				{
-					BlendShape.MeshHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "vi")
-				{
-					BlendShape.TargetShapeVertexIndices.Empty();
-					if (Property.DataType == ECastPropertyId::Integer32)
-						COPY_ARR(Property.IntArray, BlendShape.TargetShapeVertexIndices)
-					if (Property.DataType == ECastPropertyId::Short)
-						COPY_ARR(Property.ShortArray, BlendShape.TargetShapeVertexIndices)
-					if (Property.DataType == ECastPropertyId::Byte)
-						COPY_ARR(Property.ByteArray, BlendShape.TargetShapeVertexIndices)
-				}
-				else if (Property.PropertyName == "vp")
-				{
-					BlendShape.TargetShapeVertexPositions = Property.Vector3Array;
-				}
-				else if (Property.PropertyName == "ts")
-				{
-					BlendShape.TargetWeightScale = Property.FloatArray;
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					BlendShape.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("b"):
+					BlendShape.MeshHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("vi"):
+					Scene->WidenArray(Property, BlendShape.TargetShapeVertexIndices);
+					break;
+				case CastPropertyNameId("vp"):
+					BlendShape.TargetShapeVertexPositions = Scene->GetSpan<FVector3f>(Property).ToArray();
+					break;
+				case CastPropertyNameId("ts"):
+					BlendShape.TargetWeightScale = Scene->GetSpan<float>(Property).ToArray();
+					break;
+				default: break;
 				}
 			}
-			Model.BlendShapes.Add(BlendShape);
+			Model.BlendShapes.Add(MoveTemp(BlendShape));
 			break;
 		}
 	case 0x6C656B73: // Skeleton
@@ -483,121 +770,109 @@ void FCastManager::ProcessModelData(FCastNode& Node, FCastModelInfo& Model)
 			FCastSkeletonInfo Skeleton;
 			for (uint32 Idx : Node.ChildNodes)
 			{
-				ProcessSkeletonData(Scene->Nodes[Idx], Skeleton);
+				ProcessSkeletonData(Tree, Tree.Nodes[Idx], Skeleton);
 			}
-			Model.Skeletons.Add(Skeleton);
+			Model.Skeletons.Add(MoveTemp(Skeleton));
 			break;
 		}
 	case 0x6C74616D: // Material
 		{
 			FCastMaterialInfo Material;
 			Material.MaterialHash = Node.Header.NodeHash;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					Material.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "t")
-				{
-					Material.Type = Property.StringData;
-				}
-				else if (Property.PropertyName == "albedo")
-				{
-					Material.AlbedoFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "diffuse")
-				{
-					Material.DiffuseFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "normal")
-				{
-					Material.NormalFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "specular")
-				{
-					Material.SpecularFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "emissive")
-				{
-					Material.EmissiveFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "gloss")
-				{
-					Material.GlossFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "roughness")
-				{
-					Material.RoughnessFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "ao")
-				{
-					Material.AmbientOcclusionFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "cavity")
-				{
-					Material.CavityFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "aniso")
-				{
-					Material.AnisotropyFileHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "extra%d")
-				{
-					Material.ExtraFileHash = Property.Int64Array[0];
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					Material.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("t"):
+					Material.Type = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("albedo"):
+					Material.AlbedoFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("diffuse"):
+					Material.DiffuseFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("normal"):
+					Material.NormalFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("specular"):
+					Material.SpecularFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("emissive"):
+					Material.EmissiveFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("gloss"):
+					Material.GlossFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("roughness"):
+					Material.RoughnessFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("ao"):
+					Material.AmbientOcclusionFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("cavity"):
+					Material.CavityFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("aniso"):
+					Material.AnisotropyFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("extra%d"):
+					Material.ExtraFileHash = Scene->GetValue<uint64>(Property);
+					break;
+				default: break;
 				}
 			}
 			for (uint32 Idx : Node.ChildNodes)
 			{
-				ProcessMaterialData(Scene->Nodes[Idx], Material);
+				ProcessMaterialData(Tree, Tree.Nodes[Idx], Material);
 			}
-			int32 MatIdx = Model.Materials.Add(Material);
-			Model.MaterialMap.Add(Material.MaterialHash, MatIdx);
+			const uint64 MaterialHash = Material.MaterialHash;
+			int32 MatIdx = Model.Materials.Add(MoveTemp(Material));
+			Model.MaterialMap.Add(MaterialHash, MatIdx);
 			break;
 		}
 	}
 }
 
-void FCastManager::ProcessSkeletonData(FCastNode& Node, FCastSkeletonInfo& Skeleton)
+void FCastManager::ProcessSkeletonData(const FCastNodeTree& Tree, const FCastNode& Node, FCastSkeletonInfo& Skeleton) const
 {
 	switch (Node.Header.Identifier)
 	{
 	case 0x656E6F62: // Bone
 		{
 			FCastBoneInfo Bone;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					Bone.BoneName = Property.StringData;
-				}
-				else if (Property.PropertyName == "p")
-				{
-					Bone.ParentIndex = Property.IntArray[0];
-				}
-				else if (Property.PropertyName == "ssc")
-				{
-					Bone.SegmentScaleCompensate = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "lp")
-				{
-					Bone.LocalPosition = Property.Vector3Array[0];
-				}
-				else if (Property.PropertyName == "lr")
-				{
-					Bone.LocalRotation = Property.Vector4Array[0];
-				}
-				else if (Property.PropertyName == "wp")
-				{
-					Bone.WorldPosition = Property.Vector3Array[0];
-				}
-				else if (Property.PropertyName == "wr")
-				{
-					Bone.WorldRotation = Property.Vector4Array[0];
-				}
-				else if (Property.PropertyName == "s")
-				{
-					Bone.Scale = Property.Vector3Array[0];
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					Bone.BoneName = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("p"):
+					Bone.ParentIndex = Scene->GetValue<uint32>(Property);
+					break;
+				case CastPropertyNameId("ssc"):
+					Bone.SegmentScaleCompensate = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				case CastPropertyNameId("lp"):
+					Bone.LocalPosition = Scene->GetValue<FVector3f>(Property);
+					break;
+				case CastPropertyNameId("lr"):
+					Bone.LocalRotation = Scene->GetValue<FVector4f>(Property);
+					break;
+				case CastPropertyNameId("wp"):
+					Bone.WorldPosition = Scene->GetValue<FVector3f>(Property);
+					break;
+				case CastPropertyNameId("wr"):
+					Bone.WorldRotation = Scene->GetValue<FVector4f>(Property);
+					break;
+				case CastPropertyNameId("s"):
+					Bone.Scale = Scene->GetValue<FVector3f>(Property);
+					break;
+				default: break;
 				}
 			}
 			Skeleton.Bones.Add(Bone);
@@ -606,35 +881,32 @@ void FCastManager::ProcessSkeletonData(FCastNode& Node, FCastSkeletonInfo& Skele
 	case 0x64686B69: // IKHandle
 		{
 			FCastIKHandle IKHandle;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					IKHandle.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.StartBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.EndBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.TargetBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.PoleVectorBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.PoleBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "n")
-				{
-					IKHandle.UseTargetRotation = static_cast<bool>(Property.ByteArray[0]);
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					IKHandle.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("sb"):
+					IKHandle.StartBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("eb"):
+					IKHandle.EndBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("tb"):
+					IKHandle.TargetBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("pv"):
+					IKHandle.PoleVectorBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("pb"):
+					IKHandle.PoleBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("tr"):
+					IKHandle.UseTargetRotation = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				default: break;
 				}
 			}
 			Skeleton.IKHandles.Add(IKHandle);
@@ -643,39 +915,35 @@ void FCastManager::ProcessSkeletonData(FCastNode& Node, FCastSkeletonInfo& Skele
 	case 0x74736E63: // Constraint
 		{
 			FCastConstraint Constraint;
-			for (auto Property : Node.Properties)
+			for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
 			{
-				if (Property.PropertyName == "n")
-				{
-					Constraint.Name = Property.StringData;
-				}
-				else if (Property.PropertyName == "ct")
-				{
-					Constraint.ConstraintType = Property.StringData;
-				}
-				else if (Property.PropertyName == "cb")
-				{
-					Constraint.ConstraintBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "tb")
-				{
-					Constraint.TargetBoneHash = Property.Int64Array[0];
-				}
-				else if (Property.PropertyName == "mo")
-				{
-					Constraint.MaintainOffset = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "sx")
-				{
-					Constraint.SkipX = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "sy")
-				{
-					Constraint.SkipY = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "sz")
-				{
-					Constraint.SkipZ = static_cast<bool>(Property.ByteArray[0]);
+				switch (Property.NameId)
+				{
+				case CastPropertyNameId("n"):
+					Constraint.Name = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("ct"):
+					Constraint.ConstraintType = Scene->GetString(Property);
+					break;
+				case CastPropertyNameId("cb"):
+					Constraint.ConstraintBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("tb"):
+					Constraint.TargetBoneHash = Scene->GetValue<uint64>(Property);
+					break;
+				case CastPropertyNameId("mo"):
+					Constraint.MaintainOffset = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				case CastPropertyNameId("sx"):
+					Constraint.SkipX = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				case CastPropertyNameId("sy"):
+					Constraint.SkipY = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				case CastPropertyNameId("sz"):
+					Constraint.SkipZ = static_cast<bool>(Scene->GetValue<uint8>(Property));
+					break;
+				default: break;
 				}
 			}
 			Skeleton.Constraints.Add(Constraint);
@@ -684,120 +952,9 @@ void FCastManager::ProcessSkeletonData(FCastNode& Node, FCastSkeletonInfo& Skele
 	}
 }
 
-void FCastManager::ProcessMaterialData(FCastNode& Node, FCastMaterialInfo& Material)
-{
-	for (auto Property : Node.Properties)
-		if (Property.PropertyName == "p")
-			Material.FileMap.Add(Node.Header.NodeHash, Property.StringData);
-}
-
-void FCastManager::ProcessAnimationData(FCastNode& Node, FCastAnimationInfo& Animation)
+void FCastManager::ProcessMaterialData(const FCastNodeTree& Tree, const FCastNode& Node, FCastMaterialInfo& Material) const
 {
-	switch (Node.Header.Identifier)
-	{
-	case 0x76727563: // Curve
-		{
-			FCastCurveInfo Curve;
-			for (FCastNodeProperty& Property : Node.Properties)
-			{
-				if (Property.PropertyName == "nn")
-				{
-					Curve.NodeName = Property.StringData;
-				}
-				else if (Property.PropertyName == "kp")
-				{
-					Curve.KeyPropertyName = Property.StringData;
-				}
-				else if (Property.PropertyName == "kb")
-				{
-					if (Property.DataType == ECastPropertyId::Integer32)
-						COPY_ARR(Property.IntArray, Curve.KeyFrameBuffer)
-					if (Property.DataType == ECastPropertyId::Short)
-						COPY_ARR(Property.ShortArray, Curve.KeyFrameBuffer)
-					if (Property.DataType == ECastPropertyId::Byte)
-						COPY_ARR(Property.ByteArray, Curve.KeyFrameBuffer)
-				}
-				else if (Property.PropertyName == "kv")
-				{
-					Curve.KeyValueBuffer.Empty();
-					if (Property.DataType == ECastPropertyId::Byte)
-						for (const auto& Val : Property.ByteArray)
-							Curve.KeyValueBuffer.Add(Val);
-					if (Property.DataType == ECastPropertyId::Short)
-						for (const auto& Val : Property.ShortArray)
-							Curve.KeyValueBuffer.Add(Val);
-					if (Property.DataType == ECastPropertyId::Integer32)
-						for (const auto& Val : Property.IntArray)
-							Curve.KeyValueBuffer.Add(Val);
-					if (Property.DataType == ECastPropertyId::Float)
-						for (const auto& Val : Property.FloatArray)
-							Curve.KeyValueBuffer.Add(Val);
-					if (Property.DataType == ECastPropertyId::Vector4)
-						for (const auto& Val : Property.Vector4Array)
-							Curve.KeyValueBuffer.Add(FVector4(Val));
-				}
-				else if (Property.PropertyName == "m")
-				{
-					Curve.Mode = Property.StringData;
-				}
-				else if (Property.PropertyName == "ab")
-				{
-					Curve.AdditiveBlendWeight = Property.FloatArray[0];
-				}
-			}
-			Animation.Curves.Add(Curve);
-			break;
-		}
-	case 0x564F4D43: // CurveModeOverride
-		{
-			FCastCurveModeOverrideInfo CurveModeOverride;
-			for (auto Property : Node.Properties)
-			{
-				if (Property.PropertyName == "nn")
-				{
-					CurveModeOverride.NodeName = Property.StringData;
-				}
-				else if (Property.PropertyName == "m")
-				{
-					CurveModeOverride.Mode = Property.StringData;
-				}
-				else if (Property.PropertyName == "ot")
-				{
-					CurveModeOverride.OverrideTranslationCurves = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "or")
-				{
-					CurveModeOverride.OverrideRotationCurves = static_cast<bool>(Property.ByteArray[0]);
-				}
-				else if (Property.PropertyName == "os")
-				{
-					CurveModeOverride.OverrideScaleCurves = static_cast<bool>(Property.ByteArray[0]);
-				}
-			}
-			Animation.CurveModeOverrides.Add(CurveModeOverride);
-			break;
-		}
-	case 0x6669746E: // NotificationTrack
-		{
-			FCastNotificationTrackInfo NotificationTrack;
-			NotificationTrack.KeyFrameBuffer.Empty();
-			for (FCastNodeProperty& Property : Node.Properties)
-			{
-				if (Property.PropertyName == "n")
-					NotificationTrack.Name = Property.StringData;
-				else if (Property.PropertyName == "kb")
-					if (Property.DataType == ECastPropertyId::Integer32)
-						for (const auto& Val : Property.IntArray)
-							NotificationTrack.KeyFrameBuffer.Add(Val);
-				// COPY_ARR(Property.IntArray, NotificationTrack.KeyFrameBuffer)
-				if (Property.DataType == ECastPropertyId::Short)
-					// for (const auto& Val : src_arr) dst_arr.Add(Val)
-					COPY_ARR(Property.ShortArray, NotificationTrack.KeyFrameBuffer)
-				if (Property.DataType == ECastPropertyId::Byte)
-					COPY_ARR(Property.ByteArray, NotificationTrack.KeyFrameBuffer)
-			}
-			Animation.NotificationTracks.Add(NotificationTrack);
-			break;
-		}
-	}
-}
+	for (const FCastNodeProperty& Property : Tree.GetProperties(Node))
+		if (Property.NameId == CastPropertyNameId("p"))
+			Material.FileMap.Add(Node.Header.NodeHash, Scene->GetString(Property));
+}
\ No newline at end of file
@@ -9,3 +9,25 @@ void FCastNode::SetName(FString& InName)
 {
 	NodeName = InName;
 }
+
+TArrayView<const FCastNodeProperty> FCastNodeTree::GetProperties(const FCastNode& Node) const
+{
+	return TArrayView<const FCastNodeProperty>(Properties.GetData() + Node.FirstProperty, Node.Header.PropertyCount);
+}
+
+uint32 FCastNodeProperty::GetElementSize(ECastPropertyId Type)
+{
+	switch (Type)
+	{
+	case ECastPropertyId::Byte: return sizeof(uint8);
+	case ECastPropertyId::Short: return sizeof(uint16);
+	case ECastPropertyId::Integer32: return sizeof(uint32);
+	case ECastPropertyId::Integer64: return sizeof(uint64);
+	case ECastPropertyId::Float: return sizeof(float);
+	case ECastPropertyId::Double: return sizeof(double);
+	case ECastPropertyId::Vector2: return sizeof(FVector2f);
+	case ECastPropertyId::Vector3: return sizeof(FVector3f);
+	case ECastPropertyId::Vector4: return sizeof(FVector4f);
+	default: return 0;
+	}
+}
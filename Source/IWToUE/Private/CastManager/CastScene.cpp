@@ -7,7 +7,7 @@
 
 int32 FCastScene::GetNodeCount() const
 {
-	return Nodes.Num();
+	return NodeCount;
 }
 
 int32 FCastScene::GetMaterialCount() const
@@ -67,11 +67,28 @@ float FCastScene::GetAnimFramerate() const
 	return 0;
 }
 
-FCastNode* FCastScene::GetNode(int32 Idx)
+void FCastScene::SetArena(const uint8* InData, int64 InSize)
 {
-	if (Nodes.IsValidIndex(Idx))
+	ArenaData = InData;
+	ArenaSize = InSize;
+}
+
+FAnsiStringView FCastScene::GetPropertyName(const FCastNodeProperty& Property) const
+{
+	if (!ArenaData)
+	{
+		return FAnsiStringView();
+	}
+	return FAnsiStringView(reinterpret_cast<const ANSICHAR*>(ArenaData + Property.GetNameOffset()), Property.NameSize);
+}
+
+FString FCastScene::GetString(const FCastNodeProperty& Property) const
+{
+	if (Property.DataType != ECastPropertyId::String || !ArenaData)
 	{
-		return &Nodes[Idx];
+		return FString();
 	}
-	return nullptr;
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(ArenaData + Property.DataOffset),
+	                             Property.ArrayLength);
+	return FString(Converted.Length(), Converted.Get());
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+﻿#include "CastManager/CastStreamReader.h"
+
+FCastStreamReader::FCastStreamReader(const FCastScene& InScene)
+	: Scene(InScene)
+	  , Reader(InScene.GetArenaData(), InScene.GetArenaSize())
+{
+}
+
+bool FCastStreamReader::ReadProperty(FArchive& Ar, const uint8* Data, int64 Size, FCastNodeProperty& Property)
+{
+	uint16 Identifier;
+	Ar << Identifier;
+	Ar << Property.NameSize;
+	Ar << Property.ArrayLength;
+
+	Property.DataType = Identifier
+		                    ? static_cast<ECastPropertyId>(Identifier)
+		                    : ECastPropertyId::String;
+
+	// 名称紧挨着数据，只记录数据在文件中的位置，不拷贝
+	const int64 NameOffset = Ar.Tell();
+	const int64 DataOffset = NameOffset + Property.NameSize;
+	if (Ar.IsError() || DataOffset > Size)
+	{
+		Ar.SetError();
+		return false;
+	}
+	Property.NameId = CastPropertyNameId(reinterpret_cast<const ANSICHAR*>(Data + NameOffset), Property.NameSize);
+
+	int64 DataSize = 0;
+	if (Property.DataType == ECastPropertyId::String)
+	{
+		const ANSICHAR* StringStart = reinterpret_cast<const ANSICHAR*>(Data + DataOffset);
+		while (DataOffset + DataSize < Size && StringStart[DataSize] != 0) ++DataSize;
+		Property.ArrayLength = static_cast<uint32>(DataSize);
+		// Skip the null terminator
+		++DataSize;
+	}
+	else
+	{
+		DataSize = static_cast<int64>(FCastNodeProperty::GetElementSize(Property.DataType)) * Property.ArrayLength;
+	}
+
+	if (DataOffset + DataSize > Size)
+	{
+		Ar.SetError();
+		return false;
+	}
+	Property.DataOffset = static_cast<uint64>(DataOffset);
+	Ar.Seek(DataOffset + DataSize);
+	return true;
+}
+
+bool FCastStreamReader::ReadNodeHeader(FCastNodeHeader& Header)
+{
+	Reader << Header.Identifier;
+	Reader << Header.NodeSize;
+	Reader << Header.NodeHash;
+	Reader << Header.PropertyCount;
+	Reader << Header.ChildCount;
+	return !Reader.IsError();
+}
+
+bool FCastStreamReader::ReadAnimation(int64 Offset, ICastAnimationVisitor& Visitor)
+{
+	Reader.Seek(Offset);
+
+	FCastNodeHeader AnimHeader;
+	if (!ReadNodeHeader(AnimHeader) || AnimHeader.Identifier != 0x6D696E61) // Animation
+	{
+		return false;
+	}
+
+	FString Name;
+	float Framerate = 30.f;
+	bool bLooping = false;
+	FCastNodeProperty Property;
+	for (uint32 i = 0; i < AnimHeader.PropertyCount; ++i)
+	{
+		if (!ReadProperty(Reader, Scene.GetArenaData(), Scene.GetArenaSize(), Property)) return false;
+		switch (Property.NameId)
+		{
+		case CastPropertyNameId("n"):
+			Name = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("f"):
+			Framerate = Scene.GetValue<float>(Property);
+			break;
+		case CastPropertyNameId("b"):
+			bLooping = static_cast<bool>(Scene.GetValue<uint8>(Property));
+			break;
+		default: break;
+		}
+	}
+
+	Visitor.BeginAnimation(Name, Framerate, bLooping);
+	for (uint32 i = 0; i < AnimHeader.ChildCount; ++i)
+	{
+		const int64 ChildOffset = Reader.Tell();
+		FCastNodeHeader ChildHeader;
+		if (!ReadNodeHeader(ChildHeader)) return false;
+
+		bool bOk = true;
+		switch (ChildHeader.Identifier)
+		{
+		case 0x76727563: // Curve
+			bOk = ReadCurve(ChildHeader, Visitor);
+			break;
+		case 0x564F4D43: // CurveModeOverride
+			bOk = ReadCurveModeOverride(ChildHeader, Visitor);
+			break;
+		case 0x6669746E: // NotificationTrack
+			bOk = ReadNotificationTrack(ChildHeader, Visitor);
+			break;
+		default: break;
+		}
+		if (!bOk || ChildOffset + ChildHeader.NodeSize > Scene.GetArenaSize()) return false;
+		// 子节点可能还有我们不关心的子节点，统一按 NodeSize 跳过
+		Reader.Seek(ChildOffset + ChildHeader.NodeSize);
+	}
+	Visitor.EndAnimation();
+	return true;
+}
+
+bool FCastStreamReader::ReadCurve(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor)
+{
+	FCastCurveView Curve;
+	FCastNodeProperty Property;
+	for (uint32 i = 0; i < Header.PropertyCount; ++i)
+	{
+		if (!ReadProperty(Reader, Scene.GetArenaData(), Scene.GetArenaSize(), Property)) return false;
+		switch (Property.NameId)
+		{
+		case CastPropertyNameId("nn"):
+			Curve.NodeName = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("kp"):
+			Curve.KeyPropertyName = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("kb"):
+			Curve.KeyFrames = GetKeyFrames(Property);
+			break;
+		case CastPropertyNameId("kv"):
+			if (Property.DataType == ECastPropertyId::Vector4)
+				Curve.QuatValues = Scene.ViewArray<FVector4f>(Property, QuatScratch);
+			else
+				Curve.FloatValues = GetFloatValues(Property);
+			break;
+		case CastPropertyNameId("m"):
+			Curve.Mode = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("ab"):
+			Curve.AdditiveBlendWeight = Scene.GetValue<float>(Property);
+			break;
+		default: break;
+		}
+	}
+	Visitor.OnCurve(Curve);
+	return true;
+}
+
+bool FCastStreamReader::ReadCurveModeOverride(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor)
+{
+	FCastCurveModeOverrideInfo CurveModeOverride;
+	FCastNodeProperty Property;
+	for (uint32 i = 0; i < Header.PropertyCount; ++i)
+	{
+		if (!ReadProperty(Reader, Scene.GetArenaData(), Scene.GetArenaSize(), Property)) return false;
+		switch (Property.NameId)
+		{
+		case CastPropertyNameId("nn"):
+			CurveModeOverride.NodeName = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("m"):
+			CurveModeOverride.Mode = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("ot"):
+			CurveModeOverride.OverrideTranslationCurves = static_cast<bool>(Scene.GetValue<uint8>(Property));
+			break;
+		case CastPropertyNameId("or"):
+			CurveModeOverride.OverrideRotationCurves = static_cast<bool>(Scene.GetValue<uint8>(Property));
+			break;
+		case CastPropertyNameId("os"):
+			CurveModeOverride.OverrideScaleCurves = static_cast<bool>(Scene.GetValue<uint8>(Property));
+			break;
+		default: break;
+		}
+	}
+	Visitor.OnCurveModeOverride(CurveModeOverride);
+	return true;
+}
+
+bool FCastStreamReader::ReadNotificationTrack(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor)
+{
+	FString Name;
+	TArrayView<const uint32> KeyFrames;
+	FCastNodeProperty Property;
+	for (uint32 i = 0; i < Header.PropertyCount; ++i)
+	{
+		if (!ReadProperty(Reader, Scene.GetArenaData(), Scene.GetArenaSize(), Property)) return false;
+		switch (Property.NameId)
+		{
+		case CastPropertyNameId("n"):
+			Name = Scene.GetString(Property);
+			break;
+		case CastPropertyNameId("kb"):
+			KeyFrames = GetKeyFrames(Property);
+			break;
+		default: break;
+		}
+	}
+	Visitor.OnNotificationTrack(Name, KeyFrames);
+	return true;
+}
+
+TArrayView<const uint32> FCastStreamReader::GetKeyFrames(const FCastNodeProperty& Property)
+{
+	if (Property.DataType == ECastPropertyId::Integer32)
+	{
+		return Scene.ViewArray<uint32>(Property, FrameScratch);
+	}
+	Scene.WidenArray(Property, FrameScratch);
+	return FrameScratch;
+}
+
+TArrayView<const float> FCastStreamReader::GetFloatValues(const FCastNodeProperty& Property)
+{
+	if (Property.DataType == ECastPropertyId::Float)
+	{
+		return Scene.ViewArray<float>(Property, FloatScratch);
+	}
+	Scene.WidenArray(Property, FloatScratch);
+	return FloatScratch;
+}
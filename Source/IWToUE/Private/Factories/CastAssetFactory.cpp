@@ -5,6 +5,7 @@
 #include "Widgets/CastImportUI.h"
 #include "SeLogChannels.h"
 #include "Utils/CastImporter.h"
+#include "Factories/CastAssetImportData.h"
 
 #define LOCTEXT_NAMESPACE "CastFactory"
 
@@ -17,6 +18,7 @@ UCastAssetFactory::UCastAssetFactory(const FObjectInitializer& ObjectInitializer
 	bOperationCanceled = false;
 	bShowOption = true;
 	bDetectImportTypeOnImport = true;
+	NumSkippedAssets = 0;
 }
 
 void UCastAssetFactory::PostInitProperties()
@@ -38,23 +40,60 @@ UClass* UCastAssetFactory::ResolveSupportedClass()
 	return UStaticMesh::StaticClass();
 }
 
-UObject* UCastAssetFactory::HandleExistingAsset(UObject* InParent, FName InName, const FString& InFilename)
+void UCastAssetFactory::CleanUp()
 {
-	UObject* ExistingObject = nullptr;
-	if (InParent)
+	Super::CleanUp();
+	if (NumSkippedAssets > 0)
 	{
-		ExistingObject = StaticFindObject(UObject::StaticClass(), InParent, *InName.ToString());
-		if (ExistingObject)
-		{
-			// TODO: 重新导入
-			FReimportHandler* ReimportHandler = nullptr;
-			UFactory* ReimportHandlerFactory = nullptr;
-			UAssetImportTask* HandlerOriginalImportTask = nullptr;
-			bool bIsObjectSupported = false;
-			UE_LOG(LogCast, Warning, TEXT("'%s' already exists and cannot be imported"), *InFilename)
-		}
+		UE_LOG(LogCast, Log, TEXT("Skipped %d unchanged cast assets"), NumSkippedAssets);
+	}
+	NumSkippedAssets = 0;
+
+	if (FCastImporter* CastImporter = FCastImporter::GetInstance(true))
+	{
+		CastImporter->ClearMaterialCaches();
+	}
+}
+
+UObject* UCastAssetFactory::HandleExistingAsset(UObject* InParent, FName InName, const FString& InFilename,
+                                                FCastImporter* CastImporter, const FCastImportOptions* ImportOptions)
+{
+	if (!InParent)
+	{
+		return nullptr;
+	}
+	UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), InParent, *InName.ToString());
+	if (!ExistingObject)
+	{
+		return nullptr;
+	}
+
+	UCastAssetImportData* ImportData = nullptr;
+	if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(ExistingObject))
+	{
+		ImportData = Cast<UCastAssetImportData>(StaticMesh->AssetImportData);
+	}
+	else if (USkeletalMesh* SkeletalMesh = Cast<USkeletalMesh>(ExistingObject))
+	{
+		ImportData = Cast<UCastAssetImportData>(SkeletalMesh->GetAssetImportData());
 	}
-	return ExistingObject;
+
+	if (!ImportData)
+	{
+		UE_LOG(LogCast, Warning, TEXT("'%s' already exists and cannot be imported"), *InFilename)
+		return ExistingObject;
+	}
+
+	// 源文件和导入选项都没变时跳过网格构建、材质和贴图导入
+	if (ImportData->IsUpToDate(CastImporter->GetSourceHash(InFilename), ImportOptions->GetHash()))
+	{
+		++NumSkippedAssets;
+		UE_LOG(LogCast, Log, TEXT("'%s' is unchanged since last import, skipped"), *InFilename);
+		return ExistingObject;
+	}
+
+	UE_LOG(LogCast, Log, TEXT("'%s' changed since last import, reimporting"), *InFilename);
+	return nullptr;
 }
 
 void UCastAssetFactory::HandleMaterialImport(FString&& ParentPath, const FString& InFilename,
@@ -163,11 +202,6 @@ UObject* UCastAssetFactory::FactoryCreateFile(
 
 	UObject* CreatedObject = nullptr;
 
-	if (UObject* ExistingObject = HandleExistingAsset(InParent, InName, InFilename))
-	{
-		return ExistingObject;
-	}
-
 	FCastImporter* CastImporter = FCastImporter::GetInstance();
 	FSceneCleanupGuard SceneCleanupGuard(CastImporter);
 
@@ -207,6 +241,12 @@ UObject* UCastAssetFactory::FactoryCreateFile(
 		RETURN_IF_PASS(bOperationCanceled, TEXT("Operator canceled"));
 	}
 
+	if (UObject* ExistingObject = HandleExistingAsset(InParent, InName, InFilename, CastImporter, ImportOptions))
+	{
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, ExistingObject);
+		return ExistingObject;
+	}
+
 	CreatedObject = ExecuteImportProcess(InParent, InName, Flags, InFilename, CastImporter, ImportOptions,
 	                                     CurrentFilename);
 
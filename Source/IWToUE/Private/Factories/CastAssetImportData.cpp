@@ -1 +1,13 @@
 ﻿#include "Factories/CastAssetImportData.h"
+
+void UCastAssetImportData::UpdateCastSource(const FString& Filename, FMD5Hash SourceHash, uint64 OptionsHash)
+{
+	Update(Filename, SourceHash.IsValid() ? &SourceHash : nullptr);
+	ImportOptionsHash = OptionsHash;
+}
+
+bool UCastAssetImportData::IsUpToDate(const FMD5Hash& SourceHash, uint64 OptionsHash) const
+{
+	return SourceHash.IsValid() && ImportOptionsHash == OptionsHash &&
+		SourceData.SourceFiles.Num() == 1 && SourceData.SourceFiles[0].FileHash == SourceHash;
+}
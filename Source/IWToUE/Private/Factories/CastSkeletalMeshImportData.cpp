@@ -0,0 +1,24 @@
+﻿#include "Factories/CastSkeletalMeshImportData.h"
+
+#include "Engine/SkeletalMesh.h"
+
+UCastSkeletalMeshImportData* UCastSkeletalMeshImportData::GetImportDataForSkeletalMesh(USkeletalMesh* SkeletalMesh,
+	UCastSkeletalMeshImportData* TemplateForCreation)
+{
+	check(SkeletalMesh);
+
+	UCastSkeletalMeshImportData* ImportData = Cast<UCastSkeletalMeshImportData>(SkeletalMesh->GetAssetImportData());
+	if (!ImportData)
+	{
+		ImportData = NewObject<UCastSkeletalMeshImportData>(SkeletalMesh, NAME_None, RF_NoFlags, TemplateForCreation);
+
+		if (SkeletalMesh->GetAssetImportData() != NULL)
+		{
+			ImportData->SourceData = SkeletalMesh->GetAssetImportData()->SourceData;
+		}
+
+		SkeletalMesh->SetAssetImportData(ImportData);
+	}
+
+	return ImportData;
+}
@@ -3,6 +3,7 @@
 #include "Misc/ScopedSlowTask.h"
 #include "Serialization/LargeMemoryReader.h"
 #include "Structures/SeAnim.h"
+#include "Utils/AnimResampleHelper.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Widgets/SeAnimOptions.h"
 #include "Widgets/SSeAnimImportOption.h"
@@ -10,6 +11,49 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SeAnimAssetFactory)
 #define LOCTEXT_NAMESPACE "C2AnimAssetFactory"
 
+namespace
+{
+	constexpr uint32 ZeroFrame = 0;
+
+	FVector3f ConvertPosition(FVector3f Position)
+	{
+		Position.Y *= -1;
+		return Position;
+	}
+
+	FQuat4f ConvertRotation(const FQuat4f& Rotation)
+	{
+		// Unreal uses other axis type than COD engine
+		FRotator3f LocalRotator = Rotation.Rotator();
+		LocalRotator.Yaw *= -1.0f;
+		LocalRotator.Roll *= -1.0f;
+		return LocalRotator.Quaternion();
+	}
+
+	// 最后一个关键帧决定轨道长度，不超过文件头记录的帧数
+	int32 GetNumberOfKeys(const FSeAnim& Anim)
+	{
+		uint32 LastFrame = 0;
+		for (const FBoneInfo& Bone : Anim.BonesInfos)
+		{
+			for (const TArray<uint32>* Frames : {
+				     &Bone.BonePositions.Frames, &Bone.BoneRotations.Frames, &Bone.BoneScale.Frames
+			     })
+			{
+				if (!Frames->IsEmpty())
+				{
+					LastFrame = FMath::Max(LastFrame, Frames->Last());
+				}
+			}
+		}
+		if (Anim.Header.FrameCountBuffer > 0)
+		{
+			LastFrame = FMath::Min(LastFrame, Anim.Header.FrameCountBuffer);
+		}
+		return static_cast<int32>(LastFrame) + 1;
+	}
+}
+
 USeAnimAssetFactory::USeAnimAssetFactory(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -76,11 +120,17 @@ UObject* USeAnimAssetFactory::FactoryCreateFile
 
 	AnimSequence->ResetAnimation();
 	Bones = Skeleton->GetReferenceSkeleton().GetRawRefBoneInfo();
+	BoneNameMap.Build(Skeleton->GetReferenceSkeleton());
 	if (TArray64<uint8> FileDataOld; FFileHelper::LoadFileToArray(FileDataOld, *Filename))
 	{
 		FLargeMemoryReader Reader(FileDataOld.GetData(), FileDataOld.Num());
 		FSeAnim* Anim = new FSeAnim();
 		Anim->ParseAnim(Reader);
+		if (Reader.IsError())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SEAnim file '%s' is truncated, only %d bones were read"), *Filename,
+			       Anim->BonesInfos.Num());
+		}
 
 		Controller.SetFrameRate(FFrameRate(Anim->Header.FrameRate, 1), bShouldTransact);
 		Controller.SetNumberOfFrames(FFrameNumber(int(Anim->Header.FrameCountBuffer)), bShouldTransact);
@@ -92,151 +142,102 @@ UObject* USeAnimAssetFactory::FactoryCreateFile
 			Controller.AddBoneCurve(BoneTreeName, bShouldTransact);
 		}
 
+		// 动画骨骼到骨架骨骼的映射只计算一次
+		const TArray<int32> SkeletonBoneIndices = BoneNameMap.Resolve(Anim->BonesInfos);
+
+		// 序列是否为叠加动画由文件头决定，骨骼的类型可以被单独覆盖。
+		// 所有骨骼都换算成完整的局部姿势再写入：叠加序列由 UE 减去参考姿势得到差值，
+		// 非叠加骨骼在参考姿势上播放时仍得到原姿势；非叠加序列中的叠加骨骼则直接叠加到参考姿势上。
+		const bool bAdditiveSequence = Anim->Header.AnimType == ESeAnimAnimationType::SEANIM_ADDITIVE;
+		if (bAdditiveSequence)
+		{
+			AnimSequence->AdditiveAnimType = AAT_LocalSpaceBase;
+			AnimSequence->RefPoseType = ABPT_RefPose;
+		}
+		int32 NumOverriddenBones = 0;
 		for (int32 BoneIndex = 0; BoneIndex < Anim->BonesInfos.Num(); BoneIndex++)
 		{
-			FBoneInfo& KeyFrameBone = Anim->BonesInfos[BoneIndex];
-			FMeshBoneInfo BoneMesh = GetBone(KeyFrameBone.Name);
-			if (BoneMesh.Name == "None") { continue; }
-			FName NewCurveName(KeyFrameBone.Name);
+			const bool bAdditiveBone = Anim->BonesInfos[BoneIndex].AnimType == ESeAnimAnimationType::SEANIM_ADDITIVE;
+			if (SkeletonBoneIndices[BoneIndex] != INDEX_NONE && bAdditiveBone != bAdditiveSequence)
+			{
+				++NumOverriddenBones;
+			}
+		}
+		if (NumOverriddenBones > 0)
+		{
+			UE_LOG(LogTemp, Warning,
+			       TEXT("SEAnim file '%s' mixes additive and non-additive bones: %d %s bones are baked against the reference pose"),
+			       *Filename, NumOverriddenBones, bAdditiveSequence ? TEXT("non-additive") : TEXT("additive"));
+		}
+
+		// 所有轨道长度一致，只分配一次
+		const int32 NumberOfKeys = GetNumberOfKeys(*Anim);
+		const TArray<FTransform>& RefBonePose = Skeleton->GetReferenceSkeleton().GetRefBonePose();
+		TArray<FVector3f> PositionKeyValues;
+		TArray<FQuat4f> RotationKeyValues;
+		TArray<FVector3f> PositionalKeys;
+		TArray<FQuat4f> RotationalKeys;
+		TArray<FVector3f> ScalingKeys;
+		PositionalKeys.SetNumUninitialized(NumberOfKeys);
+		RotationalKeys.SetNumUninitialized(NumberOfKeys);
+		ScalingKeys.SetNumUninitialized(NumberOfKeys);
 
+		for (int32 BoneIndex = 0; BoneIndex < Anim->BonesInfos.Num(); BoneIndex++)
+		{
+			const int32 SkeletonBoneIndex = SkeletonBoneIndices[BoneIndex];
+			if (SkeletonBoneIndex == INDEX_NONE) { continue; }
+			const FBoneInfo& KeyFrameBone = Anim->BonesInfos[BoneIndex];
+			const FName NewCurveName = Bones[SkeletonBoneIndex].Name;
 
-			TArray<FVector3f> PositionalKeys;
-			TArray<FQuat4f> RotationalKeys;
-			TArray<FVector3f> ScalingKeys;
+			// 相对和叠加动画以参考姿势为基准，插值是线性的，所以直接换算关键帧而不是逐帧处理
+			const FTransform3f RefPose(RefBonePose[SkeletonBoneIndex]);
+			const bool bRelativeTranslation = KeyFrameBone.AnimType == ESeAnimAnimationType::SEANIM_RELATIVE ||
+				KeyFrameBone.AnimType == ESeAnimAnimationType::SEANIM_ADDITIVE;
+			const bool bAdditiveRotation = KeyFrameBone.AnimType == ESeAnimAnimationType::SEANIM_ADDITIVE;
+			const FVector3f BaseTranslation = bRelativeTranslation ? RefPose.GetTranslation() : FVector3f::ZeroVector;
+			const FQuat4f BaseRotation = bAdditiveRotation ? RefPose.GetRotation() : FQuat4f::Identity;
 
 			// 设置位置关键帧
-			uint32 CurrentFrame = 0;
-			for (int32 i = 0; i < KeyFrameBone.BonePositions.Num(); ++i, ++CurrentFrame)
+			PositionKeyValues.Reset(KeyFrameBone.BonePositions.Num());
+			for (const FVector3f& Position : KeyFrameBone.BonePositions.Values)
 			{
-				TWraithAnimFrame<FVector3f>& BonePosAnimFrame = KeyFrameBone.BonePositions[i];
-				BonePosAnimFrame.Value[1] *= -1;
-				// 手动插值
-				if (i == 0 && BonePosAnimFrame.Frame > 0)
-				{
-					while (CurrentFrame < BonePosAnimFrame.Frame)
-					{
-						PositionalKeys.Add(BonePosAnimFrame.Value);
-						++CurrentFrame;
-					}
-				}
-				else
-				{
-					while (CurrentFrame < BonePosAnimFrame.Frame)
-					{
-						TWraithAnimFrame<FVector3f> LastBonePosAnimFrame = KeyFrameBone.BonePositions[i - 1];
-						PositionalKeys.Add(
-							FMath::Lerp(LastBonePosAnimFrame.Value, BonePosAnimFrame.Value,
-							            static_cast<float>(CurrentFrame - LastBonePosAnimFrame.Frame) /
-							            static_cast<float>(BonePosAnimFrame.Frame - LastBonePosAnimFrame.Frame)));
-						++CurrentFrame;
-					}
-				}
-				PositionalKeys.Add(BonePosAnimFrame.Value);
+				PositionKeyValues.Add(ConvertPosition(Position) + BaseTranslation);
 			}
-
-			// 设置旋转关键帧
-			FQuat4f LastRotator;
-			CurrentFrame = 0;
-			for (int32 i = 0; i < KeyFrameBone.BoneRotations.Num(); ++i, ++CurrentFrame)
+			if (PositionKeyValues.IsEmpty())
 			{
-				TWraithAnimFrame<FQuat4f> BoneRotationKeyFrame = KeyFrameBone.BoneRotations[i];
-				// Unreal uses other axis type than COD engine
-				FRotator3f LocalRotator = BoneRotationKeyFrame.Value.Rotator();
-				LocalRotator.Yaw *= -1.0f;
-				LocalRotator.Roll *= -1.0f;
-				FQuat4f NewRotator = LocalRotator.Quaternion();
-
-				// 手动插值
-				if (i == 0 && BoneRotationKeyFrame.Frame > 0)
-				{
-					while (CurrentFrame < BoneRotationKeyFrame.Frame)
-					{
-						RotationalKeys.Add(NewRotator);
-						++CurrentFrame;
-					}
-				}
-				else
-				{
-					while (CurrentFrame < BoneRotationKeyFrame.Frame)
-					{
-						uint32 LastFrame = KeyFrameBone.BoneRotations[i - 1].Frame;
-						RotationalKeys.Add(
-							FMath::Lerp(LastRotator, NewRotator,
-							            static_cast<float>(CurrentFrame - LastFrame) /
-							            static_cast<float>(BoneRotationKeyFrame.Frame - LastFrame)));
-						++CurrentFrame;
-					}
-				}
-				LastRotator = NewRotator;
-				RotationalKeys.Add(NewRotator);
+				PositionKeyValues.Add(BaseTranslation);
 			}
+			AnimResampleHelper::ResampleVectorTrack(KeyFrameBone.BonePositions.Frames.IsEmpty()
+				                                        ? MakeArrayView(&ZeroFrame, 1)
+				                                        : MakeArrayView(KeyFrameBone.BonePositions.Frames),
+			                                        PositionKeyValues, PositionalKeys);
 
-			// 设置缩放关键帧
-			CurrentFrame = 0;
-			for (int32 i = 0; i < KeyFrameBone.BoneScale.Num(); ++i, ++CurrentFrame)
+			// 设置旋转关键帧
+			RotationKeyValues.Reset(KeyFrameBone.BoneRotations.Num());
+			for (const FQuat4f& Rotation : KeyFrameBone.BoneRotations.Values)
 			{
-				TWraithAnimFrame<FVector3f> BoneScaleKeyFrame = KeyFrameBone.BoneScale[i];
-
-				// 手动插值
-				if (i == 0 && BoneScaleKeyFrame.Frame > 0)
-				{
-					while (CurrentFrame < BoneScaleKeyFrame.Frame)
-					{
-						ScalingKeys.Add(BoneScaleKeyFrame.Value);
-						++CurrentFrame;
-					}
-				}
-				else
-				{
-					while (CurrentFrame < BoneScaleKeyFrame.Frame)
-					{
-						TWraithAnimFrame<FVector3f> LastScaleFrame = KeyFrameBone.BoneScale[i - 1];
-						ScalingKeys.Add(
-							FMath::Lerp(LastScaleFrame.Value, BoneScaleKeyFrame.Value,
-							            static_cast<float>(CurrentFrame - LastScaleFrame.Frame) /
-							            static_cast<float>(BoneScaleKeyFrame.Frame - LastScaleFrame.Frame)));
-						++CurrentFrame;
-					}
-				}
-				ScalingKeys.Add(BoneScaleKeyFrame.Value);
+				RotationKeyValues.Add(BaseRotation * ConvertRotation(Rotation));
 			}
-
-			// 保证长度相同
-			int32 ArrLen = FMath::Max3(PositionalKeys.Num(), RotationalKeys.Num(), ScalingKeys.Num());
-			while (PositionalKeys.Num() < ArrLen)
+			if (RotationKeyValues.IsEmpty())
 			{
-				if (PositionalKeys.IsEmpty())
-				{
-					PositionalKeys.Add(FVector3f::ZeroVector);
-				}
-				else
-				{
-					FVector3f LastItem = PositionalKeys.Last();
-					PositionalKeys.Add(LastItem);
-				}
+				RotationKeyValues.Add(BaseRotation);
 			}
-			while (RotationalKeys.Num() < ArrLen)
+			AnimResampleHelper::ResampleRotationTrack(KeyFrameBone.BoneRotations.Frames.IsEmpty()
+				                                          ? MakeArrayView(&ZeroFrame, 1)
+				                                          : MakeArrayView(KeyFrameBone.BoneRotations.Frames),
+			                                          RotationKeyValues, RotationalKeys);
+
+			// 设置缩放关键帧
+			if (KeyFrameBone.BoneScale.Num() > 0)
 			{
-				if (RotationalKeys.IsEmpty())
-				{
-					RotationalKeys.Add(FQuat4f());
-				}
-				else
-				{
-					FQuat4f LastItem = RotationalKeys.Last();
-					RotationalKeys.Add(LastItem);
-				}
+				AnimResampleHelper::ResampleVectorTrack(KeyFrameBone.BoneScale.Frames, KeyFrameBone.BoneScale.Values,
+				                                        ScalingKeys);
 			}
-			while (ScalingKeys.Num() < ArrLen)
+			else
 			{
-				if (ScalingKeys.IsEmpty())
+				for (FVector3f& Scale : ScalingKeys)
 				{
-					ScalingKeys.Add(FVector3f::OneVector);
-				}
-				else
-				{
-					FVector3f LastItem = ScalingKeys.Last();
-					ScalingKeys.Add(LastItem);
+					Scale = FVector3f::OneVector;
 				}
 			}
 
@@ -259,28 +260,55 @@ UObject* USeAnimAssetFactory::FactoryCreateFile
 	return AnimSequence;
 }
 
-FMeshBoneInfo USeAnimAssetFactory::GetBone(const FString& AnimBoneName)
+int32 USeAnimAssetFactory::FindBoneIndex(const FString& AnimBoneName) const
 {
-	for (const auto& Bone : Bones)
+	return BoneNameMap.Find(AnimBoneName);
+}
+
+void FSeAnimBoneNameMap::Build(const FReferenceSkeleton& RefSkeleton)
+{
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+	IndexByName.Reset();
+	IndexByName.Reserve(BoneInfos.Num());
+	for (int32 Index = 0; Index < BoneInfos.Num(); ++Index)
 	{
-		if (Bone.Name.ToString() == AnimBoneName)
-		{
-			return Bone;
-		}
+		IndexByName.FindOrAdd(BoneInfos[Index].Name, Index);
 	}
-	return FMeshBoneInfo();
 }
 
-int USeAnimAssetFactory::GetBoneIndex(const FString& AnimBoneName)
+int32 FSeAnimBoneNameMap::Find(const FString& BoneName) const
 {
-	for (int32 Index = 0; Index < Bones.Num(); ++Index)
+	// FNAME_Find 不会为骨架中不存在的名字创建 FName
+	const FName Name(*BoneName, FNAME_Find);
+	if (Name.IsNone())
 	{
-		if (Bones[Index].Name.ToString() == AnimBoneName)
-		{
-			return Index;
-		}
+		return INDEX_NONE;
 	}
-	return -69;
+	const int32* Index = IndexByName.Find(Name);
+	return Index ? *Index : INDEX_NONE;
+}
+
+TArray<int32> FSeAnimBoneNameMap::Resolve(const TArray<FBoneInfo>& AnimBones) const
+{
+	TArray<int32> Indices;
+	Indices.Reserve(AnimBones.Num());
+	for (const FBoneInfo& AnimBone : AnimBones)
+	{
+		Indices.Add(Find(AnimBone.Name));
+	}
+	return Indices;
+}
+
+FMeshBoneInfo USeAnimAssetFactory::GetBone(const FString& AnimBoneName)
+{
+	const int32 Index = FindBoneIndex(AnimBoneName);
+	return Index != INDEX_NONE ? Bones[Index] : FMeshBoneInfo();
+}
+
+int USeAnimAssetFactory::GetBoneIndex(const FString& AnimBoneName)
+{
+	const int32 Index = FindBoneIndex(AnimBoneName);
+	return Index != INDEX_NONE ? Index : -69;
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -1,5 +1,6 @@
 #include "Factories/SeModelAssetFactory.h"
 #include "FileHelpers.h"
+#include "SeLogChannels.h"
 #include "Interfaces/IMainFrameModule.h"
 #include "Serialization/LargeMemoryReader.h"
 #include "Structures/SeModel.h"
@@ -35,7 +36,14 @@ UObject* USeModelAssetFactory::FactoryCreateFile(UClass* InClass, UObject* InPar
 	FString FileName_Fix = FPaths::GetBaseFilename(Filename);
 	FLargeMemoryReader Reader(FileDataOld.GetData(), FileDataOld.Num());
 	SeModel* Mesh = new SeModel(FileName_Fix, Reader);
+	const bool bReadFailed = Reader.IsError();
 	Reader.Close();
+	if (bReadFailed)
+	{
+		UE_LOG(LogCast, Error, TEXT("Failed to read SEModel file %s, the file is truncated or malformed"), *Filename);
+		delete Mesh;
+		return nullptr;
+	}
 
 	if (!UserSettings->bInitialized)
 	{
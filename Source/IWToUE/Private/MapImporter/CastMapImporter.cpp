@@ -1,6 +1,10 @@
 ﻿#include "MapImporter/CastMapImporter.h"
 
+#include "ContentBrowserModule.h"
 #include "DesktopPlatformModule.h"
+#include "IContentBrowserSingleton.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Engine/StaticMeshActor.h"
 #include "Factories/CastAssetFactory.h"
 #include "MapImporter/GreyMap.h"
@@ -72,6 +76,16 @@ TSharedRef<SWidget> FCastMapImporter::CreateToolbarDropdown()
 				FCanExecuteAction()),
 			NAME_None
 		);
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("CastAnimBatchButton", "Import Cast Animations"),
+			LOCTEXT("CastAnimBatchButtonTooltip",
+			        "Import multiple cast animation files onto the skeleton selected in the Content Browser"),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateRaw(this, &FCastMapImporter::ImportAnimationsForSkeleton),
+				FCanExecuteAction()),
+			NAME_None
+		);
 	}
 	MenuBuilder.EndSection();
 
@@ -258,6 +272,69 @@ void FCastMapImporter::ImportAssetFronCord()
 	FSlateApplication::Get().AddWindow(BrowserWindow);
 }
 
+void FCastMapImporter::ImportAnimationsForSkeleton()
+{
+	// 目标骨架取内容浏览器中选中的资产
+	IContentBrowserSingleton& ContentBrowser =
+		FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser").Get();
+	TArray<FAssetData> SelectedAssets;
+	ContentBrowser.GetSelectedAssets(SelectedAssets);
+
+	USkeleton* Skeleton = nullptr;
+	for (const FAssetData& AssetData : SelectedAssets)
+	{
+		if (AssetData.IsInstanceOf(USkeleton::StaticClass()))
+		{
+			Skeleton = Cast<USkeleton>(AssetData.GetAsset());
+			break;
+		}
+	}
+	if (!Skeleton)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("CastAnimBatchNoSkeleton",
+		                                              "Select a skeleton in the Content Browser first."));
+		return;
+	}
+
+	TArray<FString> Filenames;
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!DesktopPlatform->OpenFileDialog(nullptr, TEXT("Select cast animations"), FPaths::ProjectContentDir(),
+	                                     TEXT(""), TEXT("Cast files (*.cast)|*.cast"), EFileDialogFlags::Multiple,
+	                                     Filenames) || Filenames.IsEmpty())
+	{
+		return;
+	}
+
+	// 动画放在骨架所在目录的 Animations 下
+	const FString PackagePath = FPaths::Combine(
+		FPackageName::GetLongPackagePath(Skeleton->GetPackage()->GetName()), TEXT("Animations"));
+
+	// 所有文件共用一次选项对话框的设置
+	UCastImportUI* ImportUI = NewObject<UCastImportUI>();
+	ImportUI->Skeleton = Skeleton;
+	FCastImporter* CastImporter = FCastImporter::GetInstance();
+	bool bCanceled = false;
+	bool bImportAll = false;
+	CastImporter->GetImportOptions(ImportUI, true, false, PackagePath, bCanceled, bImportAll, Filenames[0]);
+	if (bCanceled)
+	{
+		return;
+	}
+	FCastImportOptions Options{};
+	FCastImporter::ApplyImportUI(ImportUI, Options);
+	Options.bImportAnimations = true;
+
+	FScopedSlowTask SlowTask(1, LOCTEXT("CastAnimBatchTask", "Importing cast animations"));
+	SlowTask.MakeDialog();
+	SlowTask.EnterProgressFrame(1);
+
+	const TArray<UAnimSequence*> AnimSequences =
+		CastImporter->ImportAnimBatch(Filenames, PackagePath, Skeleton, Options);
+
+	TArray<UObject*> CreatedAssets(AnimSequences);
+	ContentBrowser.SyncBrowserToAssets(CreatedAssets);
+}
+
 FReply FCastMapImporter::OnConfirmImport(TSharedRef<SWindow> DialogWindow, TSharedPtr<SEditableTextBox> JsonFilePathBox,
                                          TSharedPtr<SEditableTextBox> ModelFolderPathBox,
                                          TSharedPtr<SEditableTextBox> ModelPathBox,
@@ -274,6 +351,11 @@ FReply FCastMapImporter::OnConfirmImport(TSharedRef<SWindow> DialogWindow, TShar
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContents);
 		if (FJsonSerializer::Deserialize(Reader, JsonParsed) && JsonParsed.IsValid())
 		{
+			// 所有新导入的模型最后一起构建，放置 Actor 也推迟到构建之后
+			FCastImporter* CastImporter = FCastImporter::GetInstance();
+			CastImporter->SetDeferStaticMeshBuilds(true);
+			TArray<TPair<UStaticMesh*, FTransform>> Placements;
+
 			for (auto& JsonObjectValue : JsonParsed->AsArray())
 			{
 				FTransform ModelTransform;
@@ -326,7 +408,6 @@ FReply FCastMapImporter::OnConfirmImport(TSharedRef<SWindow> DialogWindow, TShar
 					FString ModelFilePath = FString::Printf(TEXT("%s.cast"), *ModelFileBasePath);
 					FString FileName_Fix = FPaths::GetBaseFilename(ModelFilePath);
 
-					FCastImporter* CastImporter = FCastImporter::GetInstance();
 					FSceneCleanupGuard SceneCleanupGuard(CastImporter);
 
 					FCastImportOptions* ImportOptions = CastImporter->GetImportOptions();
@@ -336,6 +417,7 @@ FReply FCastMapImporter::OnConfirmImport(TSharedRef<SWindow> DialogWindow, TShar
 					ImportOptions->TextureFormat = "png";
 					ImportOptions->bImportAsSkeletal = false;
 					ImportOptions->bImportMesh = true;
+					ImportOptions->bGenerateLightmapUVs = false;
 					ImportOptions->MaterialType = ECastMaterialType::CastMT_IW9;
 
 					int32 ImportType = CastImporter->GetImportType(ModelFilePath);
@@ -352,18 +434,26 @@ FReply FCastMapImporter::OnConfirmImport(TSharedRef<SWindow> DialogWindow, TShar
 				}
 				if (ModelMesh)
 				{
-					AActor* ModelActor = GEditor->AddActor(
-						GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
-						AStaticMeshActor::StaticClass(), FTransform::Identity);
-					AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(ModelActor);
-					MeshActor->GetStaticMeshComponent()->SetStaticMesh(ModelMesh);
-					MeshActor->SetActorTransform(ModelTransform);
+					Placements.Emplace(ModelMesh, ModelTransform);
 				}
 				else
 				{
 					UE_LOG(LogTemp, Error, TEXT("Not found model: %s"), *Name);
 				}
 			}
+
+			CastImporter->SetDeferStaticMeshBuilds(false);
+			CastImporter->ClearMaterialCaches();
+
+			for (const TPair<UStaticMesh*, FTransform>& Placement : Placements)
+			{
+				AActor* ModelActor = GEditor->AddActor(
+					GEditor->GetEditorWorldContext().World()->GetCurrentLevel(),
+					AStaticMeshActor::StaticClass(), FTransform::Identity);
+				AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(ModelActor);
+				MeshActor->GetStaticMeshComponent()->SetStaticMesh(Placement.Key);
+				MeshActor->SetActorTransform(Placement.Value);
+			}
 		}
 	}
 
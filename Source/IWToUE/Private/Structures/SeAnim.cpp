@@ -3,6 +3,49 @@
 #include "Serialization/LargeMemoryReader.h"
 #include "Utils/BinaryReader.h"
 
+namespace
+{
+	// 帧号和关键帧数量的宽度由总帧数决定
+	int32 GetFrameIndexSize(uint32 FrameCount)
+	{
+		return FrameCount <= 0xFF ? 1 : FrameCount <= 0xFFFF ? 2 : 4;
+	}
+
+	uint32 ReadFrameIndex(FArchive& Reader, int32 FrameSize)
+	{
+		if (FrameSize == 1)
+		{
+			uint8 Index;
+			Reader << Index;
+			return Index;
+		}
+		if (FrameSize == 2)
+		{
+			uint16 Index;
+			Reader << Index;
+			return Index;
+		}
+		uint32 Index;
+		Reader << Index;
+		return Index;
+	}
+
+	// 记录没有对齐，按帧号宽度拆分到帧号和值两个数组
+	template <typename FrameType, typename T>
+	void DecodeKeys(const uint8* Data, TSeAnimTrack<T>& Track)
+	{
+		constexpr int32 KeySize = sizeof(FrameType) + sizeof(T);
+		for (int32 KeyIndex = 0; KeyIndex < Track.Num(); ++KeyIndex)
+		{
+			const uint8* Record = Data + static_cast<int64>(KeyIndex) * KeySize;
+			FrameType Frame;
+			FMemory::Memcpy(&Frame, Record, sizeof(FrameType));
+			Track.Frames[KeyIndex] = Frame;
+			FMemory::Memcpy(&Track.Values[KeyIndex], Record + sizeof(FrameType), sizeof(T));
+		}
+	}
+}
+
 void FSeAnim::ParseAnim(FLargeMemoryReader& Reader)
 {
 	ParseHeader(Reader);
@@ -72,14 +115,20 @@ TArray<FAnimationBoneModifier> FSeAnim::ParseAnimModifiers(FLargeMemoryReader& R
 void FSeAnim::ParseBoneData(FLargeMemoryReader& Reader, const TArray<FAnimationBoneModifier>& AnimModifiers, const TArray<FString>& BoneNames)
 {
 
+	BonesInfos.Reserve(Header.BoneCountBuffer);
 	for (uint32_t an_tag = 0; an_tag < Header.BoneCountBuffer; an_tag++)
 	{
-		TArray<TWraithAnimFrame<FVector3f>> Locations;
-		TArray<TWraithAnimFrame<FVector3f>> Scales;
-		TArray<TWraithAnimFrame<FQuat4f>> Rotations;
-		FBoneInfo BoneInfo;
+		FBoneInfo& BoneInfo = BonesInfos.AddDefaulted_GetRef();
 		BoneInfo.Name = BoneNames[an_tag];
 		BoneInfo.Index = an_tag;
+		BoneInfo.AnimType = Header.AnimType;
+		for (const FAnimationBoneModifier& AnimModifier : AnimModifiers)
+		{
+			if (AnimModifier.Index == an_tag)
+			{
+				BoneInfo.AnimType = AnimModifier.AnimType;
+			}
+		}
 
 		uint8_t random_flag;
 		Reader << random_flag;
@@ -95,7 +144,11 @@ void FSeAnim::ParseBoneData(FLargeMemoryReader& Reader, const TArray<FAnimationB
 		{
 			ParseKeyframeData<FVector3f>(Reader, BoneInfo.BoneScale);
 		}
-		BonesInfos.Add(BoneInfo);
+		if (Reader.IsError())
+		{
+			BonesInfos.Pop();
+			return;
+		}
 	}
 
 }
@@ -146,50 +199,40 @@ FVector3f FSeAnim::FixPositionAbsolute(FVector3f QuatPos, FVector3f InitialPos)
 	return QuatPos;
 }
 template <typename T>
-void FSeAnim::ParseKeyframeData(FLargeMemoryReader& Reader, TArray<TWraithAnimFrame<T>>& KeyframeArray)
+void FSeAnim::ParseKeyframeData(FLargeMemoryReader& Reader, TSeAnimTrack<T>& Track)
 {
-	uint32_t keys;
-	if (Header.FrameCountBuffer <= 0xFF)
-	{
-		uint8_t byteIndex;
-		Reader << byteIndex;
-		keys = byteIndex;
-	}
-	else if (Header.FrameCountBuffer <= 0xFFFF)
-	{
-		uint16_t byte16;
-		Reader << byte16;
-		keys = byte16;
-	}
-	else
+	const int32 FrameSize = GetFrameIndexSize(Header.FrameCountBuffer);
+	const uint32 KeyCount = ReadFrameIndex(Reader, FrameSize);
+
+	// 每个关键帧是 帧号 + 值 的定长记录，先按数量检查剩余数据再一次分配
+	const int64 KeySize = FrameSize + sizeof(T);
+	if (Reader.IsError() || KeyCount * KeySize > Reader.TotalSize() - Reader.Tell())
 	{
-		Reader << keys;
+		Reader.SetError();
+		return;
 	}
+	Track.Frames.SetNumUninitialized(KeyCount);
+	Track.Values.SetNumUninitialized(KeyCount);
+	if (KeyCount == 0) return;
 
-	for (uint32_t key = 0; key < keys; key++)
+	if (Reader.IsByteSwapping())
 	{
-		TWraithAnimFrame<T> AnimFrame;
-		uint32_t KeyFrame;
-		if (Header.FrameCountBuffer <= 0xFF)
-		{
-			uint8_t byteIndex;
-			Reader << byteIndex;
-			KeyFrame = byteIndex;
-		}
-		else if (Header.FrameCountBuffer <= 0xFFFF)
-		{
-			uint16_t byte16;
-			Reader << byte16;
-			KeyFrame = byte16;
-		}
-		else
+		for (uint32 KeyIndex = 0; KeyIndex < KeyCount; ++KeyIndex)
 		{
-			Reader << KeyFrame;
+			Track.Frames[KeyIndex] = ReadFrameIndex(Reader, FrameSize);
+			Reader << Track.Values[KeyIndex];
 		}
-		AnimFrame.Frame = KeyFrame;
-		T KeyValue;
-		Reader << KeyValue;
-		AnimFrame.Value = KeyValue;
-		KeyframeArray.Add(AnimFrame);
+		return;
+	}
+
+	const TArray<uint8> KeyData = FBinaryReader::ReadList<uint8>(Reader, KeyCount * KeySize);
+	switch (FrameSize)
+	{
+	case 1: DecodeKeys<uint8>(KeyData.GetData(), Track);
+		break;
+	case 2: DecodeKeys<uint16>(KeyData.GetData(), Track);
+		break;
+	default: DecodeKeys<uint32>(KeyData.GetData(), Track);
+		break;
 	}
 }
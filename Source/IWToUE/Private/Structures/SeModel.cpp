@@ -70,7 +70,12 @@ SeModel::SeModel(const FString& Filename, FLargeMemoryReader& Reader)
 			Surfaces[SurfaceIndex] = new FSeModelSurface(Reader, Header->HeaderBoneCount, SurfaceIndex,
 			                                               SurfaceVertCounter, bUseUVs, bUseNormals, bUseColors,
 			                                               bUseWeights);
-			SurfaceVertCounter += Surfaces[SurfaceIndex]->Vertexes.Num();
+			SurfaceVertCounter += Surfaces[SurfaceIndex]->Positions.Num();
+			if (Reader.IsError())
+			{
+				Surfaces.SetNum(SurfaceIndex + 1);
+				return;
+			}
 		}
 	}
 
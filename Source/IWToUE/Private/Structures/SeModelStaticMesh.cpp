@@ -66,26 +66,26 @@ FMeshDescription SeModelStaticMesh::CreateMeshDescription(SeModel* InMesh)
 	// 为每个 Surface 上的顶点创建顶点ID和顶点实例ID，并设置对应的位置、法线、颜色和UV坐标。
 	for (const auto Surface : InMesh->Surfaces)
 	{
-		for (int i = 0; i < Surface->Vertexes.Num(); i++)
+		for (int i = 0; i < Surface->Positions.Num(); i++)
 		{
 			const FVertexID VertexID = MeshDescription.CreateVertex();
-			TargetVertexPositions[VertexID] = FVector3f(Surface->Vertexes[i].Position.X,
-			                                            -Surface->Vertexes[i].Position.Y,
-			                                            Surface->Vertexes[i].Position.Z);
+			TargetVertexPositions[VertexID] = FVector3f(Surface->Positions[i].X,
+			                                            -Surface->Positions[i].Y,
+			                                            Surface->Positions[i].Z);
 			VertexIndexToVertexID.Add(VertexID);
 
 			const FVertexInstanceID VertexInstanceID = MeshDescription.CreateVertexInstance(VertexID);
 			VertexIndexToVertexInstanceID.Add(VertexInstanceID);
 			GlobalVertexIndex++;
 
-			TargetVertexInstanceNormals[VertexInstanceID] = FVector3f(Surface->Vertexes[i].Normal.X,
-			                                                          -Surface->Vertexes[i].Normal.Y,
-			                                                          Surface->Vertexes[i].Normal.Z);
-			TargetVertexInstanceColors[VertexInstanceID] = Surface->Vertexes[i].Color.ToVector();
+			TargetVertexInstanceNormals[VertexInstanceID] = FVector3f(Surface->Normals[i].X,
+			                                                          -Surface->Normals[i].Y,
+			                                                          Surface->Normals[i].Z);
+			TargetVertexInstanceColors[VertexInstanceID] = Surface->Colors[i].ToVector();
 			for (int u = 0; u < InMesh->UVSetCount; u++)
 			{
 				TargetVertexInstanceUVs.Set(VertexInstanceID, u,
-				                            FVector2f(Surface->Vertexes[i].UV.X, Surface->Vertexes[i].UV.Y));
+				                            Surface->UVs[i]);
 			}
 		}
 	}
@@ -220,18 +220,15 @@ USkeletalMesh* SeModelStaticMesh::CreateSkeletalMesh(UObject* ParentPackage, SeM
 	TArray<SkeletalMeshImportData::FRawBoneInfluence> Influences;
 	for (const auto& Surface : InMesh->Surfaces)
 	{
-		for (const auto& Vertex : Surface->Vertexes)
+		for (const auto& [VertexIndex, WeightID, WeightValue] : Surface->Weights)
 		{
-			for (const auto& [VertexIndex, WeightID, WeightValue] : Vertex.Weights)
+			if (WeightValue > 0)
 			{
-				if (WeightValue > 0)
-				{
-					SkeletalMeshImportData::FRawBoneInfluence Influence;
-					Influence.BoneIndex = WeightID;
-					Influence.VertexIndex = VertexIndex;
-					Influence.Weight = WeightValue;
-					Influences.Add(Influence);
-				}
+				SkeletalMeshImportData::FRawBoneInfluence Influence;
+				Influence.BoneIndex = WeightID;
+				Influence.VertexIndex = VertexIndex;
+				Influence.Weight = WeightValue;
+				Influences.Add(Influence);
 			}
 		}
 	}
@@ -244,18 +241,15 @@ USkeletalMesh* SeModelStaticMesh::CreateSkeletalMesh(UObject* ParentPackage, SeM
 
 	for (const auto& Surface : InMesh->Surfaces)
 	{
-		for (const auto& Vertex : Surface->Vertexes)
+		for (const auto& [VertexIndex, WeightID, WeightValue] : Surface->Weights)
 		{
-			for (const auto& [VertexIndex, WeightID, WeightValue] : Vertex.Weights)
+			if (WeightValue > 0)
 			{
-				if (WeightValue > 0)
-				{
-					SkeletalMeshImportData::FRawBoneInfluence Influence;
-					Influence.BoneIndex = WeightID;
-					Influence.VertexIndex = VertexIndex;
-					Influence.Weight = WeightValue;
-					Influences.Add(Influence);
-				}
+				SkeletalMeshImportData::FRawBoneInfluence Influence;
+				Influence.BoneIndex = WeightID;
+				Influence.VertexIndex = VertexIndex;
+				Influence.Weight = WeightValue;
+				Influences.Add(Influence);
 			}
 		}
 	}
@@ -1,7 +1,121 @@
 ﻿#include "Structures/SeModelSurface.h"
+#include "SeLogChannels.h"
 #include "Serialization/LargeMemoryReader.h"
 #include "Utils/BinaryReader.h"
 
+namespace
+{
+	/**
+	 * 分配前检查剩余数据是否足够容纳 Count 个定长记录，计数来自文件，损坏时可能非常大。
+	 * 不足时标记读取失败。
+	 */
+	bool CheckStreamSize(FLargeMemoryReader& Reader, int64 Count, int64 ElementSize)
+	{
+		if (Reader.IsError() || Count > MAX_int32 || Count * ElementSize > Reader.TotalSize() - Reader.Tell())
+		{
+			UE_LOG(LogCast, Error, TEXT("SEModel surface stream of %lld x %lld bytes exceeds the remaining data"),
+			       Count, ElementSize);
+			Reader.SetError();
+			return false;
+		}
+		return true;
+	}
+
+	// 权重记录为 骨骼索引(1/2/4 字节) + float，没有对齐
+	template <typename IdType>
+	void DecodeWeights(const uint8* Data, TArray<FSeModelWeight>& Weights, uint32 InfluenceCount,
+	                   int32 VertexOffset)
+	{
+		constexpr int32 RecordSize = sizeof(IdType) + sizeof(float);
+		// Weights.Num() 恰好是 顶点数 * InfluenceCount，按顶点嵌套循环，避免逐个权重做除法
+		const uint8* Record = Data;
+		FSeModelWeight* Weight = Weights.GetData();
+		const int32 NumVertices = Weights.Num() / InfluenceCount;
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+		{
+			for (uint32 Influence = 0; Influence < InfluenceCount; ++Influence, ++Weight, Record += RecordSize)
+			{
+				IdType WeightID;
+				FMemory::Memcpy(&WeightID, Record, sizeof(IdType));
+				Weight->WeightID = WeightID;
+				FMemory::Memcpy(&Weight->WeightValue, Record + sizeof(IdType), sizeof(float));
+				Weight->VertexIndex = VertexIndex + VertexOffset;
+			}
+		}
+	}
+
+	/**
+	 * 整块读取面索引并按位宽展开为 uint32。先对整个索引块求最大值做越界检查，循环内没有分支。
+	 * @return 数据不完整或有索引超出顶点数时返回 false
+	 */
+	bool CheckMaxFaceIndex(bool bHasFaces, uint32 MaxIndex, uint32 VertexCount)
+	{
+		if (bHasFaces && MaxIndex >= VertexCount)
+		{
+			UE_LOG(LogCast, Error, TEXT("SEModel face index %u is out of range, surface has %u vertices"),
+			       MaxIndex, VertexCount);
+			return false;
+		}
+		return true;
+	}
+
+	template <typename IndexType>
+	bool ReadFaces(FLargeMemoryReader& Reader, TArray<FGfxFace>& Faces, uint32 VertexCount, int32 VertexOffset,
+	               bool bReversed)
+	{
+		// 4 字节索引不反转，FGfxFace 与文件中连续的三个 uint32 布局相同，直接读入 Faces，省去中间数组
+		if constexpr (sizeof(IndexType) == sizeof(uint32))
+		{
+			static_assert(sizeof(FGfxFace) == 3 * sizeof(uint32), "FGfxFace must match three packed uint32 indices");
+			if (!bReversed && !Reader.IsByteSwapping())
+			{
+				Reader.Serialize(Faces.GetData(), static_cast<int64>(Faces.Num()) * sizeof(FGfxFace));
+				if (Reader.IsError())
+				{
+					return false;
+				}
+
+				uint32 MaxIndex = 0;
+				for (FGfxFace& Face : Faces)
+				{
+					MaxIndex = FMath::Max3(MaxIndex, FMath::Max(Face.Index[0], Face.Index[1]), Face.Index[2]);
+					Face.Index[0] += VertexOffset;
+					Face.Index[1] += VertexOffset;
+					Face.Index[2] += VertexOffset;
+				}
+				return CheckMaxFaceIndex(!Faces.IsEmpty(), MaxIndex, VertexCount);
+			}
+		}
+
+		const TArray<IndexType> Indices = FBinaryReader::ReadList<IndexType>(Reader, Faces.Num() * 3);
+		// 读取失败时数组内容未初始化，不能参与越界检查
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		IndexType MaxIndex = 0;
+		for (const IndexType Index : Indices)
+		{
+			MaxIndex = FMath::Max(MaxIndex, Index);
+		}
+		if (!CheckMaxFaceIndex(!Indices.IsEmpty(), MaxIndex, VertexCount))
+		{
+			return false;
+		}
+
+		for (int32 FaceIndex = 0; FaceIndex < Faces.Num(); ++FaceIndex)
+		{
+			const IndexType* Index = &Indices[FaceIndex * 3];
+			FGfxFace& Face = Faces[FaceIndex];
+			Face.Index[0] = (bReversed ? Index[2] : Index[0]) + VertexOffset;
+			Face.Index[1] = Index[1] + VertexOffset;
+			Face.Index[2] = (bReversed ? Index[0] : Index[2]) + VertexOffset;
+		}
+		return true;
+	}
+}
+
 FSeModelSurface::FSeModelSurface(FLargeMemoryReader& Reader, uint32_t BufferBoneCount, uint16_t SurfaceCount,
                                  const int GlobalSurfaceVertCounter, bool bUseUVs, bool bUseNormals,
                                  bool bUseColors, bool bUseWeights)
@@ -25,96 +139,109 @@ FSeModelSurface::FSeModelSurface(FLargeMemoryReader& Reader, uint32_t BufferBone
 	Reader << VertexCount;
 	Reader << FaceCount;
 
-	// 读取顶点
-	Vertexes.SetNum(VertexCount);
-	for (auto& Vertex : Vertexes)
-	{
-		Reader << Vertex.Position;
-	}
-	for (auto& Vertex : Vertexes)
-	{
-		Reader << Vertex.UV;
-	}
-	for (auto& Vertex : Vertexes)
-	{
-		Reader << Vertex.Normal;
-	}
-	for (auto& Vertex : Vertexes)
-	{
-		Reader << Vertex.Color;
-	}
-	for (uint32 i = 0; i < VertexCount; ++i)
+	SurfaceName = FString::Format(TEXT("surf_{0}"), {SurfaceCount});
+
+	// 读取顶点，每个流都是定长记录，数量已知
+	if (!CheckStreamSize(Reader, VertexCount, sizeof(FVector3f))) return;
+	Positions = FBinaryReader::ReadList<FVector3f>(Reader, VertexCount);
+	if (!CheckStreamSize(Reader, VertexCount, sizeof(FVector2f))) return;
+	UVs = FBinaryReader::ReadList<FVector2f>(Reader, VertexCount);
+	if (!CheckStreamSize(Reader, VertexCount, sizeof(FVector3f))) return;
+	Normals = FBinaryReader::ReadList<FVector3f>(Reader, VertexCount);
+	if (!CheckStreamSize(Reader, VertexCount, sizeof(FSeModelVertexColor))) return;
+	Colors = FBinaryReader::ReadList<FSeModelVertexColor>(Reader, VertexCount);
+	ReadWeights(Reader);
+	if (Reader.IsError()) return;
+
+	// 读取面
+	Faces = ParseFaces(Reader);
+	if (Reader.IsError()) return;
+	// 读取材质
+	if (!CheckStreamSize(Reader, MaterialReferenceCount, sizeof(int32))) return;
+	Materials = FBinaryReader::ReadList<int32>(Reader, MaterialReferenceCount);
+}
+
+void FSeModelSurface::ReadWeights(FLargeMemoryReader& Reader)
+{
+	const int32 IdSize = BoneCountBuffer <= 0xFF ? 1 : BoneCountBuffer <= 0xFFFF ? 2 : 4;
+	const int64 NumWeights = static_cast<int64>(VertexCount) * MaxSkinInfluence;
+	if (!CheckStreamSize(Reader, NumWeights, IdSize + sizeof(float))) return;
+	Weights.SetNumUninitialized(NumWeights);
+	if (Weights.IsEmpty()) return;
+
+	if (Reader.IsByteSwapping())
 	{
-		Vertexes[i].Weights.SetNum(MaxSkinInfluence);
-		for (FSeModelWeight& Weight : Vertexes[i].Weights)
+		for (int32 WeightIndex = 0; WeightIndex < Weights.Num(); ++WeightIndex)
 		{
-			if (BoneCountBuffer <= 0xFF)
+			FSeModelWeight& Weight = Weights[WeightIndex];
+			if (IdSize == 1)
 			{
-				uint8_t WeightID;
+				uint8 WeightID;
 				Reader << WeightID;
 				Weight.WeightID = WeightID;
 			}
-			else if (BoneCountBuffer <= 0xFFFF)
+			else if (IdSize == 2)
 			{
-				uint16_t WeightID;
+				uint16 WeightID;
 				Reader << WeightID;
 				Weight.WeightID = WeightID;
 			}
 			else
 			{
-				uint32_t WeightID;
-				Reader << WeightID;
-				Weight.WeightID = WeightID;
+				Reader << Weight.WeightID;
 			}
 			Reader << Weight.WeightValue;
-			Weight.VertexIndex = i + SurfaceVertexCounter;
+			Weight.VertexIndex = WeightIndex / MaxSkinInfluence + SurfaceVertexCounter;
 		}
+		return;
 	}
 
-	// 读取面
-	Faces = ParseFaces(Reader);
-	// 读取材质
-	Materials = FBinaryReader::ReadList<int32>(Reader, MaterialReferenceCount);
-
-	SurfaceName = FString::Format(TEXT("surf_{0}"), {SurfaceCount});
+	// 整块读取后再拆分记录
+	const TArray<uint8> WeightData = FBinaryReader::ReadList<uint8>(
+		Reader, Weights.Num() * (IdSize + sizeof(float)));
+	if (Reader.IsError())
+	{
+		Weights.Reset();
+		return;
+	}
+	switch (IdSize)
+	{
+	case 1: DecodeWeights<uint8>(WeightData.GetData(), Weights, MaxSkinInfluence, SurfaceVertexCounter);
+		break;
+	case 2: DecodeWeights<uint16>(WeightData.GetData(), Weights, MaxSkinInfluence, SurfaceVertexCounter);
+		break;
+	default: DecodeWeights<uint32>(WeightData.GetData(), Weights, MaxSkinInfluence, SurfaceVertexCounter);
+		break;
+	}
 }
 
 TArray<FGfxFace> FSeModelSurface::ParseFaces(FLargeMemoryReader& Reader) const
 {
+	// 索引宽度由顶点数决定，整块读取后展开；1/2 字节索引按逆序存储
 	TArray<FGfxFace> RetFaces;
-	RetFaces.SetNum(FaceCount);
-	for (FGfxFace& Face : RetFaces)
+	const int32 IndexSize = VertexCount <= 0xFF ? 1 : VertexCount <= 0xFFFF ? 2 : 4;
+	// 按索引总数检查，FaceCount * 3 在 64 位下计算，不会回绕
+	if (!CheckStreamSize(Reader, static_cast<int64>(FaceCount) * 3, IndexSize))
 	{
-		if (VertexCount <= 0xFF)
-		{
-			uint8 Index1, Index2, Index3;
-			Reader << Index3;
-			Reader << Index2;
-			Reader << Index1;
-			Face.Index[0] = Index1 + SurfaceVertexCounter;
-			Face.Index[1] = Index2 + SurfaceVertexCounter;
-			Face.Index[2] = Index3 + SurfaceVertexCounter;
-		}
-		else if (VertexCount <= 0xFFFF)
-		{
-			uint16 Index1, Index2, Index3;
-			Reader << Index3;
-			Reader << Index2;
-			Reader << Index1;
-			Face.Index[0] = Index1 + SurfaceVertexCounter;
-			Face.Index[1] = Index2 + SurfaceVertexCounter;
-			Face.Index[2] = Index3 + SurfaceVertexCounter;
-		}
-		else
-		{
-			uint32 Index1, Index2, Index3;
-			Reader << Index1;
-			Reader << Index2;
-			Reader << Index3;
-			Face.Index[0] = Index1 + SurfaceVertexCounter;
-			Face.Index[1] = Index2 + SurfaceVertexCounter;
-			Face.Index[2] = Index3 + SurfaceVertexCounter;
-		}
+		return RetFaces;
+	}
+	RetFaces.SetNumUninitialized(FaceCount);
+	bool bValid;
+	switch (IndexSize)
+	{
+	case 1: bValid = ReadFaces<uint8>(Reader, RetFaces, VertexCount, SurfaceVertexCounter, true);
+		break;
+	case 2: bValid = ReadFaces<uint16>(Reader, RetFaces, VertexCount, SurfaceVertexCounter, true);
+		break;
+	default: bValid = ReadFaces<uint32>(Reader, RetFaces, VertexCount, SurfaceVertexCounter, false);
+		break;
+	}
+
+	// 文件损坏时标记读取失败，由调用方放弃导入
+	if (!bValid || Reader.IsError())
+	{
+		Reader.SetError();
+		RetFaces.Reset();
 	}
 	return RetFaces;
 }
@@ -0,0 +1,201 @@
+﻿#include "Misc/AutomationTest.h"
+#include "CastManager/CastAnimation.h"
+#include "Utils/AnimResampleHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 NumCurveBones = 150;
+	constexpr int32 NumCurveKeys = 4000;
+	const TCHAR* const CurveProperties[] = {TEXT("tx"), TEXT("ty"), TEXT("tz"), TEXT("rq")};
+
+	struct FSyntheticCurve
+	{
+		FString NodeName;
+		FString KeyPropertyName;
+		TArray<uint32> Frames;
+		TArray<FVector4f> Values;
+	};
+
+	// 帧号严格递增，间隔 1~3 帧
+	void BuildCurveFixture(TArray<FSyntheticCurve>& OutCurves, uint32& OutNumFrames)
+	{
+		FRandomStream Random(0xCA57);
+		OutNumFrames = 0;
+		for (int32 Bone = 0; Bone < NumCurveBones; ++Bone)
+		{
+			for (const TCHAR* Property : CurveProperties)
+			{
+				FSyntheticCurve& Curve = OutCurves.AddDefaulted_GetRef();
+				Curve.NodeName = FString::Printf(TEXT("j_bone_%d"), Bone);
+				Curve.KeyPropertyName = Property;
+				uint32 Frame = 0;
+				for (int32 Key = 0; Key < NumCurveKeys; ++Key)
+				{
+					Curve.Frames.Add(Frame);
+					Curve.Values.Add(FVector4f(FVector4f(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f),
+					                                     Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f))
+						.GetSafeNormal()));
+					Frame += 1 + Random.RandHelper(3);
+				}
+				OutNumFrames = FMath::Max(OutNumFrames, Curve.Frames.Last() + 1);
+			}
+		}
+	}
+
+	// 旧的 FVariant 插值方式：每帧通过 GetKeyValue 取两次值
+	template <typename T>
+	void InterpolateVariantKeys(const FCastCurveInfo& Curve, TArray<T>& OutValues)
+	{
+		uint32 CurrentFrame = 0;
+		uint32 LastKeyFrame = 0;
+		T LastKeyValue = T();
+		for (int32 i = 0; i < Curve.KeyFrameBuffer.Num(); ++i)
+		{
+			if (i == 0)
+			{
+				OutValues[0] = Curve.GetKeyValue(i).GetValue<T>();
+			}
+			else
+			{
+				while (CurrentFrame <= Curve.KeyFrameBuffer[i])
+				{
+					const float Alpha = static_cast<float>(CurrentFrame - LastKeyFrame) /
+						static_cast<float>(Curve.KeyFrameBuffer[i] - LastKeyFrame);
+					OutValues[CurrentFrame] = FMath::Lerp(LastKeyValue, Curve.GetKeyValue(i).GetValue<T>(), Alpha);
+					++CurrentFrame;
+				}
+			}
+			LastKeyFrame = Curve.KeyFrameBuffer[i];
+			LastKeyValue = Curve.GetKeyValue(i).GetValue<T>();
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCastCurveStorageBenchmark, "IWToUE.Cast.CurveStorage.TypedVsVariant",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCastCurveStorageBenchmark::RunTest(const FString& Parameters)
+{
+	TArray<FSyntheticCurve> Fixture;
+	uint32 NumFrames = 0;
+	BuildCurveFixture(Fixture, NumFrames);
+
+	// 类型化路径：直接写入 SoA 缓冲，按轨道重采样
+	TArray<FCastCurveInfo> TypedCurves;
+	TArray<TArray<float>> TypedFloats;
+	TArray<uint32> TypedFloatLastFrames;
+	TArray<TArray<FVector4f>> TypedQuats;
+	const double TypedStart = FPlatformTime::Seconds();
+	for (const FSyntheticCurve& Source : Fixture)
+	{
+		FCastCurveInfo& Curve = TypedCurves.AddDefaulted_GetRef();
+		Curve.NodeName = Source.NodeName;
+		Curve.KeyPropertyName = Source.KeyPropertyName;
+		Curve.KeyFrameBuffer.Reserve(Source.Frames.Num());
+		if (Curve.IsQuaternion())
+		{
+			Curve.QuatValueBuffer.Reserve(Source.Frames.Num());
+			for (int32 Key = 0; Key < Source.Frames.Num(); ++Key)
+			{
+				Curve.AddKey(Source.Frames[Key], Source.Values[Key]);
+			}
+			TArray<FVector4f>& Out = TypedQuats.AddDefaulted_GetRef();
+			Out.SetNumZeroed(NumFrames);
+			AnimResampleHelper::ResampleQuatTrack(Curve.KeyFrameBuffer, Curve.QuatValueBuffer, Out);
+		}
+		else
+		{
+			Curve.FloatValueBuffer.Reserve(Source.Frames.Num());
+			for (int32 Key = 0; Key < Source.Frames.Num(); ++Key)
+			{
+				Curve.AddKey(Source.Frames[Key], Source.Values[Key].X);
+			}
+			TypedFloatLastFrames.Add(Source.Frames.Last());
+			TArray<float>& Out = TypedFloats.AddDefaulted_GetRef();
+			Out.SetNumZeroed(NumFrames);
+			AnimResampleHelper::ResampleFloatTrack(Curve.KeyFrameBuffer, Curve.FloatValueBuffer, Out);
+		}
+	}
+	const double TypedSeconds = FPlatformTime::Seconds() - TypedStart;
+
+	// 兼容接口路径：AddKey(FVariant) 写入，GetKeyValue 逐帧读取
+	TArray<FCastCurveInfo> VariantCurves;
+	TArray<TArray<float>> VariantFloats;
+	TArray<TArray<FVector4>> VariantQuats;
+	const double VariantStart = FPlatformTime::Seconds();
+	for (const FSyntheticCurve& Source : Fixture)
+	{
+		FCastCurveInfo& Curve = VariantCurves.AddDefaulted_GetRef();
+		Curve.NodeName = Source.NodeName;
+		Curve.KeyPropertyName = Source.KeyPropertyName;
+		if (Curve.IsQuaternion())
+		{
+			for (int32 Key = 0; Key < Source.Frames.Num(); ++Key)
+			{
+				Curve.AddKey(Source.Frames[Key], FVariant(FVector4(Source.Values[Key])));
+			}
+			TArray<FVector4>& Out = VariantQuats.AddDefaulted_GetRef();
+			Out.SetNumZeroed(NumFrames);
+			InterpolateVariantKeys(Curve, Out);
+		}
+		else
+		{
+			for (int32 Key = 0; Key < Source.Frames.Num(); ++Key)
+			{
+				Curve.AddKey(Source.Frames[Key], FVariant(Source.Values[Key].X));
+			}
+			TArray<float>& Out = VariantFloats.AddDefaulted_GetRef();
+			Out.SetNumZeroed(NumFrames);
+			InterpolateVariantKeys(Curve, Out);
+		}
+	}
+	const double VariantSeconds = FPlatformTime::Seconds() - VariantStart;
+
+	// 两条路径的关键帧必须完全一致
+	for (int32 CurveIndex = 0; CurveIndex < TypedCurves.Num(); ++CurveIndex)
+	{
+		const FCastCurveInfo& Typed = TypedCurves[CurveIndex];
+		const FCastCurveInfo& Variant = VariantCurves[CurveIndex];
+		const FString What = Typed.NodeName + TEXT(".") + Typed.KeyPropertyName;
+		TestTrue(What + TEXT(" key frames"), Typed.KeyFrameBuffer == Variant.KeyFrameBuffer);
+		TestTrue(What + TEXT(" float values"), Typed.FloatValueBuffer == Variant.FloatValueBuffer);
+		TestTrue(What + TEXT(" quaternion values"), Typed.QuatValueBuffer == Variant.QuatValueBuffer);
+		for (int32 Key = 0; Key < Typed.KeyFrameBuffer.Num(); ++Key)
+		{
+			const bool bSame = Typed.IsQuaternion()
+				                   ? FVector4f(Variant.GetKeyValue(Key).GetValue<FVector4>()) == Typed.QuatValueBuffer[Key]
+				                   : Variant.GetKeyValue(Key).GetValue<float>() == Typed.FloatValueBuffer[Key];
+			if (!bSame)
+			{
+				AddError(FString::Printf(TEXT("%s key %d differs through GetKeyValue"), *What, Key));
+				break;
+			}
+		}
+	}
+
+	// 位移曲线的重采样结果与旧的逐帧插值一致(只差浮点舍入)，旧实现不填充最后一个关键帧之后的帧
+	for (int32 TrackIndex = 0; TrackIndex < TypedFloats.Num(); ++TrackIndex)
+	{
+		for (uint32 Frame = 0; Frame <= TypedFloatLastFrames[TrackIndex]; ++Frame)
+		{
+			if (!FMath::IsNearlyEqual(TypedFloats[TrackIndex][Frame], VariantFloats[TrackIndex][Frame], 1.e-4f))
+			{
+				AddError(FString::Printf(TEXT("Float track %d frame %u: %f vs %f"), TrackIndex, Frame,
+				                         TypedFloats[TrackIndex][Frame], VariantFloats[TrackIndex][Frame]));
+				break;
+			}
+		}
+	}
+
+	const int32 NumKeys = Fixture.Num() * NumCurveKeys;
+	AddInfo(FString::Printf(TEXT("%d curves, %d keys, %u frames: typed %.2f ms, FVariant shim %.2f ms (%.1fx)"),
+	                        Fixture.Num(), NumKeys, NumFrames, TypedSeconds * 1000.0, VariantSeconds * 1000.0,
+	                        VariantSeconds / FMath::Max(TypedSeconds, UE_DOUBLE_SMALL_NUMBER)));
+	TestTrue(TEXT("Typed SoA curves are faster than the FVariant shim"), TypedSeconds < VariantSeconds);
+
+	return true;
+}
+
+#endif
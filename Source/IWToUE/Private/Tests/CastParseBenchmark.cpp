@@ -0,0 +1,209 @@
+﻿#include "Misc/AutomationTest.h"
+#include "CastManager/CastManager.h"
+#include "CastManager/CastModel.h"
+#include "CastManager/CastNode.h"
+#include "CastManager/CastRoot.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// 两个模型共 5 个网格，每个 1M 顶点、2M 个三角形，两个子树可以并行解码
+	constexpr int32 NumVerticesPerMesh = 1'000'000;
+	constexpr int32 NumFacesPerMesh = NumVerticesPerMesh * 2;
+	constexpr int32 NumMeshesPerModel[] = {3, 2};
+	constexpr int32 NumBenchmarkRuns = 3;
+
+	// 按 cast 格式顺序写出节点和属性，节点结束时回填 NodeSize
+	class FCastFileWriter
+	{
+	public:
+		TArray64<uint8> Data;
+
+		template <typename T>
+		void Write(const T& Value)
+		{
+			Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+		}
+
+		int64 BeginNode(uint32 Identifier, uint32 PropertyCount, uint32 ChildCount)
+		{
+			const int64 NodeOffset = Data.Num();
+			Write(Identifier);
+			Write<uint32>(0); // NodeSize，EndNode 时回填
+			Write<uint64>(NodeOffset);
+			Write(PropertyCount);
+			Write(ChildCount);
+			return NodeOffset;
+		}
+
+		void EndNode(int64 NodeOffset)
+		{
+			const uint32 NodeSize = static_cast<uint32>(Data.Num() - NodeOffset);
+			FMemory::Memcpy(Data.GetData() + NodeOffset + sizeof(uint32), &NodeSize, sizeof(NodeSize));
+		}
+
+		template <typename T>
+		void WriteArrayProperty(const ANSICHAR* Name, const TArray<T>& Values)
+		{
+			WritePropertyHeader(TCastPropertyType<T>::Id, Name, Values.Num());
+			Data.Append(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(T));
+		}
+
+		template <typename T>
+		void WriteValueProperty(const ANSICHAR* Name, const T& Value)
+		{
+			WritePropertyHeader(TCastPropertyType<T>::Id, Name, 1);
+			Write(Value);
+		}
+
+		void WriteStringProperty(const ANSICHAR* Name, const ANSICHAR* Value)
+		{
+			WritePropertyHeader(ECastPropertyId::String, Name, 1);
+			Data.Append(reinterpret_cast<const uint8*>(Value), FCStringAnsi::Strlen(Value) + 1);
+		}
+
+	private:
+		void WritePropertyHeader(ECastPropertyId Type, const ANSICHAR* Name, int32 ArrayLength)
+		{
+			const uint16 NameSize = static_cast<uint16>(FCStringAnsi::Strlen(Name));
+			Write(static_cast<uint16>(Type));
+			Write(NameSize);
+			Write(static_cast<uint32>(ArrayLength));
+			Data.Append(reinterpret_cast<const uint8*>(Name), NameSize);
+		}
+	};
+
+	void BuildCastFile(TArray64<uint8>& OutFile)
+	{
+		FRandomStream Random(0xCA57);
+		TArray<FVector3f> Positions;
+		TArray<FVector3f> Normals;
+		TArray<FVector2f> UVs;
+		TArray<uint32> Colors;
+		TArray<uint32> Faces;
+		Positions.SetNumUninitialized(NumVerticesPerMesh);
+		Normals.SetNumUninitialized(NumVerticesPerMesh);
+		UVs.SetNumUninitialized(NumVerticesPerMesh);
+		Colors.SetNumUninitialized(NumVerticesPerMesh);
+		Faces.SetNumUninitialized(NumFacesPerMesh * 3);
+
+		FCastFileWriter Writer;
+		int32 NumMeshes = 0;
+		for (const int32 NumModelMeshes : NumMeshesPerModel)
+		{
+			NumMeshes += NumModelMeshes;
+		}
+		Writer.Data.Reserve(256 + static_cast<int64>(NumMeshes) *
+			(NumVerticesPerMesh * (sizeof(FVector3f) * 2 + sizeof(FVector2f) + sizeof(uint32)) +
+				NumFacesPerMesh * 3 * sizeof(uint32) + 128));
+
+		Writer.Write<uint32>(0x74736163); // cast
+		Writer.Write<uint32>(1);
+		Writer.Write<uint32>(1);
+		Writer.Write<uint32>(0);
+
+		const int64 RootOffset = Writer.BeginNode(0x746F6F72, 0, UE_ARRAY_COUNT(NumMeshesPerModel));
+		for (int32 ModelIndex = 0; ModelIndex < UE_ARRAY_COUNT(NumMeshesPerModel); ++ModelIndex)
+		{
+			const int64 ModelOffset = Writer.BeginNode(0x6C646F6D, 1, NumMeshesPerModel[ModelIndex]);
+			Writer.WriteStringProperty("n", TCHAR_TO_ANSI(*FString::Printf(TEXT("model_%d"), ModelIndex)));
+			for (int32 MeshIndex = 0; MeshIndex < NumMeshesPerModel[ModelIndex]; ++MeshIndex)
+			{
+				for (int32 i = 0; i < NumVerticesPerMesh; ++i)
+				{
+					Positions[i] = FVector3f(Random.FRandRange(-100.f, 100.f), Random.FRandRange(-100.f, 100.f),
+					                         Random.FRandRange(-100.f, 100.f));
+					Normals[i] = FVector3f(Random.GetUnitVector());
+					UVs[i] = FVector2f(Random.FRand(), Random.FRand());
+					Colors[i] = Random.GetUnsignedInt();
+				}
+				for (uint32& Index : Faces)
+				{
+					Index = Random.RandHelper(NumVerticesPerMesh);
+				}
+
+				const int64 MeshOffset = Writer.BeginNode(0x6873656D, 7, 0);
+				Writer.WriteStringProperty("n", TCHAR_TO_ANSI(*FString::Printf(TEXT("mesh_%d_%d"), ModelIndex,
+					                           MeshIndex)));
+				Writer.WriteArrayProperty("vp", Positions);
+				Writer.WriteArrayProperty("vn", Normals);
+				Writer.WriteArrayProperty("u0", UVs);
+				Writer.WriteArrayProperty("c0", Colors);
+				Writer.WriteArrayProperty("f", Faces);
+				Writer.WriteValueProperty<uint64>("m", 0x1000 + MeshIndex);
+				Writer.EndNode(MeshOffset);
+			}
+			Writer.EndNode(ModelOffset);
+		}
+		Writer.EndNode(RootOffset);
+
+		OutFile = MoveTemp(Writer.Data);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCastParseBenchmark, "IWToUE.Cast.Parse.SyntheticMeshFile",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCastParseBenchmark::RunTest(const FString& Parameters)
+{
+	TArray64<uint8> File;
+	BuildCastFile(File);
+	int32 NumMeshes = 0;
+	for (const int32 NumModelMeshes : NumMeshesPerModel)
+	{
+		NumMeshes += NumModelMeshes;
+	}
+
+	// Initialize 会接管数据，每次运行前复制一份，复制不计入耗时
+	double ParseSeconds = TNumericLimits<double>::Max();
+	for (int32 Run = 0; Run < NumBenchmarkRuns; ++Run)
+	{
+		TArray64<uint8> FileCopy = File;
+		FCastManager CastManager;
+		const double Start = FPlatformTime::Seconds();
+		const bool bInitialized = CastManager.Initialize(MoveTemp(FileCopy), TEXT("SyntheticMeshFile.cast"));
+		const bool bImported = bInitialized && CastManager.Import();
+		ParseSeconds = FMath::Min(ParseSeconds, FPlatformTime::Seconds() - Start);
+
+		if (!TestTrue(TEXT("Synthetic cast file imports"), bImported))
+		{
+			return false;
+		}
+		if (Run > 0)
+		{
+			continue;
+		}
+
+		TestEqual(TEXT("Root count"), CastManager.Scene->Roots.Num(), 1);
+		TestEqual(TEXT("Vertex count"), CastManager.GetVertexNum(), NumMeshes * NumVerticesPerMesh);
+		TestEqual(TEXT("Face count"), CastManager.GetFaceNum(), NumMeshes * NumFacesPerMesh);
+		if (CastManager.Scene->Roots.Num() == 1)
+		{
+			const TArray<FCastModelInfo>& Models = CastManager.Scene->Roots[0].Models;
+			if (TestEqual(TEXT("Model count"), Models.Num(), static_cast<int32>(UE_ARRAY_COUNT(NumMeshesPerModel))))
+			{
+				for (int32 ModelIndex = 0; ModelIndex < Models.Num(); ++ModelIndex)
+				{
+					TestEqual(TEXT("Model name"), Models[ModelIndex].Name, FString::Printf(TEXT("model_%d"), ModelIndex));
+					TestEqual(TEXT("Mesh count"), Models[ModelIndex].Meshes.Num(), NumMeshesPerModel[ModelIndex]);
+					for (const FCastMeshInfo& Mesh : Models[ModelIndex].Meshes)
+					{
+						TestEqual(TEXT("Normal count"), Mesh.VertexNormals.Num(), NumVerticesPerMesh);
+						TestEqual(TEXT("UV count"), Mesh.VertexUV.Num(), NumVerticesPerMesh);
+						TestEqual(TEXT("Color count"), Mesh.VertexColor.Num(), NumVerticesPerMesh);
+					}
+				}
+			}
+		}
+	}
+
+	const double FileMegabytes = File.Num() / (1024.0 * 1024.0);
+	AddInfo(FString::Printf(TEXT("Parsed %d vertices / %d faces (%.1f MB) in %.2f ms (%.0f MB/s)"),
+	                        NumMeshes * NumVerticesPerMesh, NumMeshes * NumFacesPerMesh, FileMegabytes,
+	                        ParseSeconds * 1000.0, ParseSeconds > 0.0 ? FileMegabytes / ParseSeconds : 0.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,324 @@
+﻿#include "Misc/AutomationTest.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "Utils/CastImporter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// 两个 Root、三个模型，网格大小不同，面索引和权重都随机，保证各网格的偏移互不相同
+	void BuildSceneFixture(TArray<FCastRoot>& OutRoots)
+	{
+		FRandomStream Random(0x5E1A);
+		struct FModelDesc
+		{
+			int32 RootIndex;
+			int32 NumBones;
+			int32 NumMaterials;
+			TArray<int32> VertexCounts;
+		};
+		const FModelDesc ModelDescs[] = {
+			{0, 40, 2, {3, 517}},
+			{0, 25, 1, {64}},
+			{1, 33, 3, {2048, 1, 300}},
+		};
+		const uint32 MaxWeights[] = {1, 4, 2, 8, 1, 3};
+
+		OutRoots.SetNum(2);
+		int32 GlobalMeshIndex = 0;
+		for (int32 ModelIndex = 0; ModelIndex < UE_ARRAY_COUNT(ModelDescs); ++ModelIndex)
+		{
+			const FModelDesc& Desc = ModelDescs[ModelIndex];
+			FCastModelInfo& Model = OutRoots[Desc.RootIndex].Models.AddDefaulted_GetRef();
+			FCastSkeletonInfo& Skeleton = Model.Skeletons.AddDefaulted_GetRef();
+			for (int32 BoneIndex = 0; BoneIndex < Desc.NumBones; ++BoneIndex)
+			{
+				FCastBoneInfo& Bone = Skeleton.Bones.AddDefaulted_GetRef();
+				Bone.BoneName = FString::Printf(TEXT("bone_%d"), BoneIndex);
+				Bone.ParentIndex = BoneIndex - 1;
+			}
+			for (int32 MaterialIndex = 0; MaterialIndex < Desc.NumMaterials; ++MaterialIndex)
+			{
+				FCastMaterialInfo& Material = Model.Materials.AddDefaulted_GetRef();
+				Material.MaterialHash = static_cast<uint64>(ModelIndex + 1) << 32 | MaterialIndex;
+				Material.Name = FString::Printf(TEXT("mtl_%d_%d"), ModelIndex, MaterialIndex);
+				Model.MaterialMap.Add(Material.MaterialHash, MaterialIndex);
+			}
+
+			for (const int32 NumVertices : Desc.VertexCounts)
+			{
+				FCastMeshInfo& Mesh = Model.Meshes.AddDefaulted_GetRef();
+				Mesh.MaxWeight = MaxWeights[GlobalMeshIndex];
+				Mesh.MaterialHash = Model.Materials[Random.RandHelper(Desc.NumMaterials)].MaterialHash;
+				for (int32 i = 0; i < NumVertices; ++i)
+				{
+					Mesh.VertexPositions.Add(FVector3f(Random.FRandRange(-100.f, 100.f),
+					                                   Random.FRandRange(-100.f, 100.f),
+					                                   Random.FRandRange(-100.f, 100.f)));
+					Mesh.VertexNormals.Add(FVector3f(Random.GetUnitVector()));
+					Mesh.VertexUV.Add(FVector2f(Random.FRand(), Random.FRand()));
+					// 部分网格没有顶点色
+					if (GlobalMeshIndex % 2 == 0)
+					{
+						Mesh.VertexColor.Add(Random.GetUnsignedInt());
+					}
+					for (uint32 w = 0; w < Mesh.MaxWeight; ++w)
+					{
+						Mesh.VertexWeightBone.Add(Random.RandHelper(Desc.NumBones));
+						Mesh.VertexWeightValue.Add(Random.FRand());
+					}
+				}
+				const int32 NumFaces = NumVertices * 2;
+				for (int32 i = 0; i < NumFaces * 3; ++i)
+				{
+					Mesh.Faces.Add(Random.RandHelper(NumVertices));
+				}
+				++GlobalMeshIndex;
+			}
+		}
+	}
+
+	// 与 ImportSkeletalMesh 相同的材质分配，得到 FillSkeletalMeshGeometry 的输入
+	void BuildMeshSlices(TArray<FCastRoot>& Roots, FSkeletalMeshImportData& Data, TArray<FCastMeshSlice>& OutSlices)
+	{
+		int32 BoneOffset = 0;
+		TMap<uint32, int32> DataMatMap;
+		for (FCastRoot& Root : Roots)
+		{
+			for (FCastModelInfo& Model : Root.Models)
+			{
+				for (FCastMeshInfo& Mesh : Model.Meshes)
+				{
+					uint32 ModelMatIdx = *Model.MaterialMap.Find(Mesh.MaterialHash);
+					int32 MatIdx;
+					if (int32* FindRes = DataMatMap.Find(ModelMatIdx))
+					{
+						MatIdx = *FindRes;
+					}
+					else
+					{
+						SkeletalMeshImportData::FMaterial NewMaterial;
+						NewMaterial.MaterialImportName = Model.Materials[ModelMatIdx].Name;
+						MatIdx = Data.Materials.Add(NewMaterial);
+						DataMatMap.Add(ModelMatIdx, MatIdx);
+					}
+
+					OutSlices.Add({&Mesh, MatIdx, BoneOffset});
+				}
+				for (FCastSkeletonInfo& Skeleton : Model.Skeletons)
+				{
+					BoneOffset += Skeleton.Bones.Num();
+				}
+			}
+		}
+	}
+
+	// 基线实现：Root→Model→Mesh 嵌套循环逐个追加顶点、面、楔形和权重，作为参考结果。
+	// 夹具中的材质没有贴图，所以省略了 CreateMaterialInstance 分支
+	void BuildBaselineGeometry(TArray<FCastRoot>& Roots, bool bReverseFace, FSkeletalMeshImportData& Data)
+	{
+		// 顶点
+		Data.Points.Empty();
+		for (FCastRoot& Root : Roots)
+		{
+			for (FCastModelInfo& Model : Root.Models)
+			{
+				for (FCastMeshInfo& Mesh : Model.Meshes)
+				{
+					for (int32 i = 0; i < Mesh.VertexPositions.Num(); ++i)
+					{
+						Data.Points.Add(FVector3f(Mesh.VertexPositions[i].X,
+						                          -Mesh.VertexPositions[i].Y,
+						                          Mesh.VertexPositions[i].Z));
+					}
+				}
+			}
+		}
+
+		Data.NumTexCoords = 2;
+		// 面 和 材质
+		int32 VertexOffset = 0;
+		TArray<int32> VertexOrder = {0, 1, 2};
+		if (bReverseFace)
+		{
+			VertexOrder = {2, 1, 0};
+		}
+		TMap<uint32, int32> DataMatMap;
+		for (FCastRoot& Root : Roots)
+		{
+			for (FCastModelInfo& Model : Root.Models)
+			{
+				for (FCastMeshInfo& Mesh : Model.Meshes)
+				{
+					uint32 ModelMatIdx = *Model.MaterialMap.Find(Mesh.MaterialHash);
+					int32 MatIdx;
+					if (int32* FindRes = DataMatMap.Find(ModelMatIdx))
+					{
+						MatIdx = *FindRes;
+					}
+					else
+					{
+						const FCastMaterialInfo& Material = Model.Materials[ModelMatIdx];
+						SkeletalMeshImportData::FMaterial NewMaterial;
+						NewMaterial.MaterialImportName = Material.Name;
+						MatIdx = Data.Materials.Add(NewMaterial);
+						DataMatMap.Add(ModelMatIdx, MatIdx);
+					}
+
+					const int32 MeshFaceCnt = Mesh.Faces.Num() / 3;
+					for (int32 FaceID = 0; FaceID < MeshFaceCnt; ++FaceID)
+					{
+						SkeletalMeshImportData::FTriangle& Triangle = Data.Faces.AddZeroed_GetRef();
+						Triangle.SmoothingGroups = 255;
+						uint32 TriangleVertexID[3] = {
+							Mesh.Faces[FaceID * 3], Mesh.Faces[FaceID * 3 + 1], Mesh.Faces[FaceID * 3 + 2]
+						};
+						for (int32 FaceVertexID = 0; FaceVertexID < 3; ++FaceVertexID)
+						{
+							int32 WedgesID = Data.Wedges.AddUninitialized();
+							SkeletalMeshImportData::FVertex& Wedges = Data.Wedges[WedgesID];
+
+							const int32 MeshVertexID = TriangleVertexID[VertexOrder[FaceVertexID]];
+							Wedges.MatIndex = MatIdx;
+							Wedges.VertexIndex = MeshVertexID + VertexOffset;
+							if (Mesh.VertexColor.IsValidIndex(MeshVertexID))
+							{
+								Wedges.Color = FColor((Mesh.VertexColor[MeshVertexID] >> 0) & 0xFF,
+								                      (Mesh.VertexColor[MeshVertexID] >> 8) & 0xFF,
+								                      (Mesh.VertexColor[MeshVertexID] >> 16) & 0xFF,
+								                      (Mesh.VertexColor[MeshVertexID] >> 24) & 0xFF);
+							}
+							Wedges.UVs[0] = FVector2f(Mesh.VertexUV[MeshVertexID].X, Mesh.VertexUV[MeshVertexID].Y);
+							Wedges.Reserved = 0;
+
+							Triangle.TangentZ[FaceVertexID] = FVector3f{
+								Mesh.VertexNormals[MeshVertexID].X,
+								-Mesh.VertexNormals[MeshVertexID].Y,
+								Mesh.VertexNormals[MeshVertexID].Z
+							};
+							Triangle.TangentZ->Normalize();
+							Triangle.WedgeIndex[FaceVertexID] = WedgesID;
+						}
+						Triangle.MatIndex = MatIdx;
+					}
+					VertexOffset += Mesh.VertexPositions.Num();
+				}
+			}
+		}
+
+		// 权重
+		VertexOffset = 0;
+		int32 BoneOffset = 0;
+		for (FCastRoot& Root : Roots)
+		{
+			for (FCastModelInfo& Model : Root.Models)
+			{
+				for (FCastMeshInfo& Mesh : Model.Meshes)
+				{
+					for (uint32 WightID = 0; WightID < (uint32)Mesh.VertexWeightBone.Num(); ++WightID)
+					{
+						Data.Influences.AddUninitialized();
+						Data.Influences.Last().VertexIndex = (int32)(WightID / Mesh.MaxWeight) + VertexOffset;
+						Data.Influences.Last().BoneIndex = Mesh.VertexWeightBone[WightID] + BoneOffset;
+						Data.Influences.Last().Weight = Mesh.VertexWeightValue[WightID];
+					}
+					VertexOffset += Mesh.VertexPositions.Num();
+				}
+				for (FCastSkeletonInfo& Skeleton : Model.Skeletons)
+				{
+					BoneOffset += Skeleton.Bones.Num();
+				}
+			}
+		}
+	}
+
+	// 基线用 AddUninitialized 分配楔形，只比较它写入过的字段；没有顶点色的网格不比较 Color
+	bool AreWedgesEquivalent(const SkeletalMeshImportData::FVertex& A, const SkeletalMeshImportData::FVertex& Baseline,
+	                         bool bHasColor)
+	{
+		return A.VertexIndex == Baseline.VertexIndex
+			&& A.UVs[0] == Baseline.UVs[0]
+			&& (!bHasColor || A.Color == Baseline.Color)
+			&& A.MatIndex == Baseline.MatIndex
+			&& A.Reserved == Baseline.Reserved;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCastSkeletalMeshParallelFillTest,
+                                 "IWToUE.Cast.SkeletalMeshImportData.MatchesBaselineAppendLoop",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCastSkeletalMeshParallelFillTest::RunTest(const FString& Parameters)
+{
+	TArray<FCastRoot> Roots;
+	BuildSceneFixture(Roots);
+
+	// 顶点是否来自带顶点色的网格，按合并后的顶点索引
+	TBitArray<> PointHasColor;
+	for (const FCastRoot& Root : Roots)
+	{
+		for (const FCastModelInfo& Model : Root.Models)
+		{
+			for (const FCastMeshInfo& Mesh : Model.Meshes)
+			{
+				PointHasColor.Add(Mesh.VertexColor.Num() > 0, Mesh.VertexPositions.Num());
+			}
+		}
+	}
+
+	for (const bool bReverseFace : {false, true})
+	{
+		FSkeletalMeshImportData Baseline;
+		BuildBaselineGeometry(Roots, bReverseFace, Baseline);
+
+		for (const bool bParallel : {false, true})
+		{
+			FSkeletalMeshImportData Data;
+			TArray<FCastMeshSlice> Slices;
+			BuildMeshSlices(Roots, Data, Slices);
+			FCastImporter::FillSkeletalMeshGeometry(Data, Slices, bReverseFace, bParallel);
+
+			const FString Suffix = FString::Printf(TEXT(" (%s%s)"), bParallel ? TEXT("parallel") : TEXT("serial"),
+			                                       bReverseFace ? TEXT(", reversed") : TEXT(""));
+			if (!TestEqual(TEXT("Point count") + Suffix, Data.Points.Num(), Baseline.Points.Num())
+				|| !TestEqual(TEXT("Face count") + Suffix, Data.Faces.Num(), Baseline.Faces.Num())
+				|| !TestEqual(TEXT("Wedge count") + Suffix, Data.Wedges.Num(), Baseline.Wedges.Num())
+				|| !TestEqual(TEXT("Influence count") + Suffix, Data.Influences.Num(), Baseline.Influences.Num())
+				|| !TestEqual(TEXT("Material count") + Suffix, Data.Materials.Num(), Baseline.Materials.Num()))
+			{
+				return false;
+			}
+
+			for (int32 i = 0; i < Baseline.Materials.Num(); ++i)
+			{
+				TestEqual(*FString::Printf(TEXT("Material %d name%s"), i, *Suffix),
+				          Data.Materials[i].MaterialImportName, Baseline.Materials[i].MaterialImportName);
+			}
+			TestTrue(TEXT("Points are bitwise identical") + Suffix,
+			         FMemory::Memcmp(Data.Points.GetData(), Baseline.Points.GetData(),
+			                         Baseline.Points.Num() * Baseline.Points.GetTypeSize()) == 0);
+			// 两边的 Faces 都是清零后再写入，填充字节一致，可以直接比较内存
+			TestTrue(TEXT("Faces are bitwise identical") + Suffix,
+			         FMemory::Memcmp(Data.Faces.GetData(), Baseline.Faces.GetData(),
+			                         Baseline.Faces.Num() * Baseline.Faces.GetTypeSize()) == 0);
+			TestTrue(TEXT("Influences are bitwise identical") + Suffix,
+			         FMemory::Memcmp(Data.Influences.GetData(), Baseline.Influences.GetData(),
+			                         Baseline.Influences.Num() * Baseline.Influences.GetTypeSize()) == 0);
+
+			int32 FirstMismatch = INDEX_NONE;
+			for (int32 i = 0; i < Baseline.Wedges.Num() && FirstMismatch == INDEX_NONE; ++i)
+			{
+				const bool bHasColor = PointHasColor[Baseline.Wedges[i].VertexIndex];
+				if (!AreWedgesEquivalent(Data.Wedges[i], Baseline.Wedges[i], bHasColor))
+				{
+					FirstMismatch = i;
+				}
+			}
+			TestEqual(TEXT("First mismatching wedge") + Suffix, FirstMismatch, INDEX_NONE);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,224 @@
+﻿#include "Misc/AutomationTest.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "Utils/CastImporter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// 多个大小不同的网格，分属不同材质，部分网格没有顶点色，面索引随机但不退化
+	void BuildModelFixture(FCastModelInfo& OutModel)
+	{
+		FRandomStream Random(0x57A71C);
+		for (int32 MaterialIndex = 0; MaterialIndex < 3; ++MaterialIndex)
+		{
+			FCastMaterialInfo& Material = OutModel.Materials.AddDefaulted_GetRef();
+			Material.MaterialHash = 0x1000 + MaterialIndex;
+			Material.Name = FString::Printf(TEXT("mtl_%d"), MaterialIndex);
+			OutModel.MaterialMap.Add(Material.MaterialHash, MaterialIndex);
+		}
+
+		const int32 VertexCounts[] = {3, 517, 64, 2048, 4, 300};
+		for (int32 MeshIndex = 0; MeshIndex < UE_ARRAY_COUNT(VertexCounts); ++MeshIndex)
+		{
+			FCastMeshInfo& Mesh = OutModel.Meshes.AddDefaulted_GetRef();
+			const int32 NumVertices = VertexCounts[MeshIndex];
+			Mesh.MaterialHash = OutModel.Materials[MeshIndex % 3].MaterialHash;
+			for (int32 i = 0; i < NumVertices; ++i)
+			{
+				Mesh.VertexPositions.Add(FVector3f(Random.FRandRange(-100.f, 100.f), Random.FRandRange(-100.f, 100.f),
+				                                   Random.FRandRange(-100.f, 100.f)));
+				Mesh.VertexNormals.Add(FVector3f(Random.GetUnitVector()));
+				Mesh.VertexUV.Add(FVector2f(Random.FRand(), Random.FRand()));
+				if (MeshIndex % 2 == 0)
+				{
+					Mesh.VertexColor.Add(Random.GetUnsignedInt());
+				}
+			}
+			const int32 NumFaces = NumVertices * 2;
+			for (int32 i = 0; i < NumFaces; ++i)
+			{
+				const int32 A = Random.RandHelper(NumVertices);
+				const int32 B = (A + 1 + Random.RandHelper(NumVertices - 1)) % NumVertices;
+				int32 C = Random.RandHelper(NumVertices);
+				while (C == A || C == B)
+				{
+					C = (C + 1) % NumVertices;
+				}
+				Mesh.Faces.Append({static_cast<uint32>(A), static_cast<uint32>(B), static_cast<uint32>(C)});
+			}
+		}
+	}
+
+	// 基线实现：逐顶点 CreateVertex/CreateVertexInstance 并通过属性引用写入，每个三角形用 CreatePolygon 创建
+	void BuildBaselineMeshDescription(FMeshDescription& MeshDescription, FCastModelInfo& Model)
+	{
+		FStaticMeshAttributes Attributes(MeshDescription);
+		Attributes.Register();
+		Attributes.RegisterTriangleNormalAndTangentAttributes();
+
+		TVertexAttributesRef<FVector3f> VertexPositions = Attributes.GetVertexPositions();
+		TVertexInstanceAttributesRef<FVector3f> VertexInstanceNormals = Attributes.GetVertexInstanceNormals();
+		TVertexInstanceAttributesRef<FVector4f> VertexInstanceColors = Attributes.GetVertexInstanceColors();
+		TVertexInstanceAttributesRef<FVector2f> VertexInstanceUVs = Attributes.GetVertexInstanceUVs();
+		TPolygonGroupAttributesRef<FName> PolygonGroupImportedMaterialSlotNames =
+			Attributes.GetPolygonGroupMaterialSlotNames();
+
+		int32 VertexCount = 0;
+		uint32 UVLayer = 0;
+
+		for (FCastMeshInfo& Mesh : Model.Meshes)
+		{
+			VertexCount += Mesh.VertexPositions.Num();
+			UVLayer = FMath::Max(UVLayer, Mesh.UVLayer);
+		}
+
+		VertexInstanceUVs.SetNumChannels(UVLayer + 1);
+		MeshDescription.ReserveNewVertices(VertexCount);
+		MeshDescription.ReserveNewVertexInstances(VertexCount);
+		MeshDescription.ReserveNewPolygons(VertexCount);
+		MeshDescription.ReserveNewEdges(VertexCount * 2);
+		TArray<FVertexInstanceID> VertexInstanceIDs;
+		VertexInstanceIDs.Reserve(VertexCount);
+		TArray<uint32> VertexIdOffset;
+		VertexIdOffset.Add(0);
+
+		for (FCastMeshInfo& Mesh : Model.Meshes)
+		{
+			for (int32 i = 0; i < (int32)Mesh.VertexPositions.Num(); ++i)
+			{
+				const FVertexID VertexID = MeshDescription.CreateVertex();
+				VertexPositions[VertexID] = FVector3f(Mesh.VertexPositions[i].X,
+				                                      -Mesh.VertexPositions[i].Y,
+				                                      Mesh.VertexPositions[i].Z);
+
+				const FVertexInstanceID VertexInstanceID = MeshDescription.CreateVertexInstance(VertexID);
+				VertexInstanceIDs.Add(VertexInstanceID);
+
+				if (Mesh.VertexNormals.IsValidIndex(i))
+				{
+					VertexInstanceNormals[VertexInstanceID] = FVector3f(Mesh.VertexNormals[i].X,
+					                                                    -Mesh.VertexNormals[i].Y,
+					                                                    Mesh.VertexNormals[i].Z);
+				}
+				if (Mesh.VertexColor.IsValidIndex(i))
+				{
+					VertexInstanceColors[VertexInstanceID] = FVector4f((Mesh.VertexColor[i] >> 0) & 0xFF,
+					                                                   (Mesh.VertexColor[i] >> 8) & 0xFF,
+					                                                   (Mesh.VertexColor[i] >> 16) & 0xFF,
+					                                                   (Mesh.VertexColor[i] >> 24) & 0xFF);
+				}
+				if (Mesh.VertexUV.IsValidIndex(i))
+					VertexInstanceUVs.Set(VertexInstanceID, 0, FVector2f(Mesh.VertexUV[i].X, Mesh.VertexUV[i].Y));
+			}
+			VertexIdOffset.Add(MeshDescription.Vertices().Num());
+		}
+
+		for (uint32 k = 0; k < (uint32)Model.Meshes.Num(); ++k)
+		{
+			const FCastMeshInfo& Mesh = Model.Meshes[k];
+			const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+
+			for (int32 i = 0; i < (int32)Mesh.Faces.Num(); i += 3)
+			{
+				TArray<FVertexInstanceID> TriangleVertexInstanceIDs;
+				for (int32 j = 0; j < 3; j++)
+				{
+					uint32 VertexIndex = Mesh.Faces[i + j] + VertexIdOffset[k];
+					TriangleVertexInstanceIDs.Add(VertexInstanceIDs[VertexIndex]);
+				}
+				MeshDescription.CreatePolygon(PolygonGroup, TriangleVertexInstanceIDs);
+			}
+
+			uint32 MatIdx = *Model.MaterialMap.Find(Mesh.MaterialHash);
+			const FCastMaterialInfo& Material = Model.Materials[MatIdx];
+			FName MatName = FName(*Material.Name);
+			PolygonGroupImportedMaterialSlotNames[PolygonGroup] = MatName;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCastStaticMeshDescriptionTest,
+                                 "IWToUE.Cast.StaticMeshDescription.MatchesBaselinePolygonPath",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCastStaticMeshDescriptionTest::RunTest(const FString& Parameters)
+{
+	FCastModelInfo Model;
+	BuildModelFixture(Model);
+
+	FMeshDescription Baseline;
+	BuildBaselineMeshDescription(Baseline, Model);
+	const FStaticMeshConstAttributes BaselineAttributes(Baseline);
+	const TVertexAttributesConstRef<FVector3f> BaselinePositions = BaselineAttributes.GetVertexPositions();
+	const TVertexInstanceAttributesConstRef<FVector3f> BaselineNormals =
+		BaselineAttributes.GetVertexInstanceNormals();
+	const TVertexInstanceAttributesConstRef<FVector4f> BaselineColors = BaselineAttributes.GetVertexInstanceColors();
+	const TVertexInstanceAttributesConstRef<FVector2f> BaselineUVs = BaselineAttributes.GetVertexInstanceUVs();
+	const TPolygonGroupAttributesConstRef<FName> BaselineSlotNames =
+		BaselineAttributes.GetPolygonGroupMaterialSlotNames();
+
+	for (const bool bParallel : {false, true})
+	{
+		FMeshDescription MeshDescription;
+		FCastImporter::FillStaticMeshDescription(MeshDescription, Model, bParallel);
+		const FStaticMeshConstAttributes Attributes(MeshDescription);
+		const TVertexAttributesConstRef<FVector3f> Positions = Attributes.GetVertexPositions();
+		const TVertexInstanceAttributesConstRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+		const TVertexInstanceAttributesConstRef<FVector4f> Colors = Attributes.GetVertexInstanceColors();
+		const TVertexInstanceAttributesConstRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+		const TPolygonGroupAttributesConstRef<FName> SlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+
+		const FString Suffix = bParallel ? TEXT(" (parallel)") : TEXT(" (serial)");
+		if (!TestEqual(TEXT("Vertex count") + Suffix, MeshDescription.Vertices().Num(), Baseline.Vertices().Num())
+			|| !TestEqual(TEXT("Vertex instance count") + Suffix, MeshDescription.VertexInstances().Num(),
+			              Baseline.VertexInstances().Num())
+			|| !TestEqual(TEXT("Triangle count") + Suffix, MeshDescription.Triangles().Num(),
+			              Baseline.Triangles().Num())
+			|| !TestEqual(TEXT("Polygon count") + Suffix, MeshDescription.Polygons().Num(), Baseline.Polygons().Num())
+			|| !TestEqual(TEXT("Polygon group count") + Suffix, MeshDescription.PolygonGroups().Num(),
+			              Baseline.PolygonGroups().Num())
+			|| !TestEqual(TEXT("UV channel count") + Suffix, UVs.GetNumChannels(), BaselineUVs.GetNumChannels()))
+		{
+			return false;
+		}
+
+		for (const FPolygonGroupID PolygonGroup : Baseline.PolygonGroups().GetElementIDs())
+		{
+			TestEqual(*FString::Printf(TEXT("Material slot of polygon group %d%s"), PolygonGroup.GetValue(), *Suffix),
+			          SlotNames[PolygonGroup], BaselineSlotNames[PolygonGroup]);
+		}
+
+		// 两边的三角形都按面顺序连续分配 id，逐个比较所属多边形组、顶点实例顺序及其属性
+		int32 FirstMismatch = INDEX_NONE;
+		for (const FTriangleID TriangleID : Baseline.Triangles().GetElementIDs())
+		{
+			const TArrayView<const FVertexInstanceID> BaselineCorners = Baseline.GetTriangleVertexInstances(TriangleID);
+			const TArrayView<const FVertexInstanceID> Corners = MeshDescription.GetTriangleVertexInstances(TriangleID);
+			bool bMatches = MeshDescription.GetTrianglePolygonGroup(TriangleID) ==
+				Baseline.GetTrianglePolygonGroup(TriangleID);
+			for (int32 Corner = 0; Corner < 3 && bMatches; ++Corner)
+			{
+				const FVertexInstanceID Instance = Corners[Corner];
+				const FVertexInstanceID BaselineInstance = BaselineCorners[Corner];
+				bMatches = Instance == BaselineInstance
+					&& Positions[MeshDescription.GetVertexInstanceVertex(Instance)] ==
+					BaselinePositions[Baseline.GetVertexInstanceVertex(BaselineInstance)]
+					&& Normals[Instance] == BaselineNormals[BaselineInstance]
+					&& Colors[Instance] == BaselineColors[BaselineInstance]
+					&& UVs.Get(Instance, 0) == BaselineUVs.Get(BaselineInstance, 0);
+			}
+			if (!bMatches)
+			{
+				FirstMismatch = TriangleID.GetValue();
+				break;
+			}
+		}
+		TestEqual(TEXT("First mismatching triangle") + Suffix, FirstMismatch, INDEX_NONE);
+	}
+
+	return true;
+}
+
+#endif
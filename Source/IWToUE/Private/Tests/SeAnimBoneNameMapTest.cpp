@@ -0,0 +1,136 @@
+﻿#include "Misc/AutomationTest.h"
+#include "Factories/SeAnimAssetFactory.h"
+#include "ReferenceSkeleton.h"
+#include "Structures/SeAnim.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 NumTestBones = 400;
+	// 计时时每种查找方式对全部骨骼重复解析的次数
+	constexpr int32 NumTimingPasses = 200;
+
+	// 名称风格混合：j_ 前缀、大小写混写、带数字后缀(FName 会拆出 Number 部分)
+	FString MakeTestBoneName(int32 Index)
+	{
+		switch (Index % 4)
+		{
+		case 0: return FString::Printf(TEXT("j_bone_%03d"), Index);
+		case 1: return FString::Printf(TEXT("J_Spine%dLe"), Index);
+		case 2: return FString::Printf(TEXT("tag_weapon_%d"), Index);
+		default: return FString::Printf(TEXT("Bip01 Finger%d"), Index);
+		}
+	}
+
+	// 旧实现的线性查找，FString == 不区分大小写，返回第一个匹配
+	int32 FindBoneIndexLinear(const FReferenceSkeleton& RefSkeleton, const FString& BoneName)
+	{
+		const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+		for (int32 Index = 0; Index < BoneInfos.Num(); ++Index)
+		{
+			if (BoneInfos[Index].Name.ToString() == BoneName)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSeAnimBoneNameMapTest, "IWToUE.SeAnim.BoneNameMap.ResolvesAllBones",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSeAnimBoneNameMapTest::RunTest(const FString& Parameters)
+{
+	FReferenceSkeleton RefSkeleton;
+	{
+		FReferenceSkeletonModifier Modifier(RefSkeleton, nullptr);
+		for (int32 Index = 0; Index < NumTestBones; ++Index)
+		{
+			const FString BoneName = MakeTestBoneName(Index);
+			Modifier.Add(FMeshBoneInfo(FName(*BoneName), BoneName, Index == 0 ? INDEX_NONE : (Index - 1) / 2),
+			             FTransform::Identity);
+		}
+	}
+	if (!TestEqual(TEXT("Synthetic skeleton bone count"), RefSkeleton.GetRawBoneNum(), NumTestBones))
+	{
+		return false;
+	}
+
+	FSeAnimBoneNameMap BoneNameMap;
+	BoneNameMap.Build(RefSkeleton);
+
+	// 动画中的骨骼名只在大小写上与骨架不同，也要找到同一根骨骼
+	TArray<FBoneInfo> AnimBones;
+	TArray<int32> ExpectedIndices;
+	for (int32 Index = 0; Index < NumTestBones; ++Index)
+	{
+		const FString BoneName = MakeTestBoneName(Index);
+		for (const FString& Query : {BoneName, BoneName.ToUpper(), BoneName.ToLower()})
+		{
+			const int32 Found = BoneNameMap.Find(Query);
+			TestEqual(*FString::Printf(TEXT("Index of '%s'"), *Query), Found, Index);
+			TestEqual(*FString::Printf(TEXT("Index of '%s' matches linear lookup"), *Query), Found,
+			          FindBoneIndexLinear(RefSkeleton, Query));
+
+			FBoneInfo& AnimBone = AnimBones.AddDefaulted_GetRef();
+			AnimBone.Name = Query;
+			ExpectedIndices.Add(Index);
+		}
+	}
+
+	for (const TCHAR* Unknown : {TEXT(""), TEXT("j_bone_"), TEXT("j_bone_400"), TEXT("tag_weapon_3"),
+	                             TEXT("not_a_bone_in_this_skeleton")})
+	{
+		TestEqual(*FString::Printf(TEXT("Index of unknown bone '%s'"), Unknown), BoneNameMap.Find(Unknown),
+		          INDEX_NONE);
+		FBoneInfo& AnimBone = AnimBones.AddDefaulted_GetRef();
+		AnimBone.Name = Unknown;
+		ExpectedIndices.Add(INDEX_NONE);
+	}
+
+	const TArray<int32> SkeletonBoneIndices = BoneNameMap.Resolve(AnimBones);
+	if (TestEqual(TEXT("Resolved index count"), SkeletonBoneIndices.Num(), ExpectedIndices.Num()))
+	{
+		for (int32 Index = 0; Index < SkeletonBoneIndices.Num(); ++Index)
+		{
+			TestEqual(*FString::Printf(TEXT("Resolved index of '%s'"), *AnimBones[Index].Name),
+			          SkeletonBoneIndices[Index], ExpectedIndices[Index]);
+		}
+	}
+
+	// 计时：对全部动画骨骼反复解析，映射表应明显快于旧的逐骨骼线性查找
+	// 累加结果防止循环被优化掉，同时核对两种方式解析出的索引一致
+	int64 MapChecksum = 0;
+	const double MapStart = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumTimingPasses; ++Pass)
+	{
+		for (const FBoneInfo& AnimBone : AnimBones)
+		{
+			MapChecksum += BoneNameMap.Find(AnimBone.Name);
+		}
+	}
+	const double MapSeconds = FPlatformTime::Seconds() - MapStart;
+
+	int64 LinearChecksum = 0;
+	const double LinearStart = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < NumTimingPasses; ++Pass)
+	{
+		for (const FBoneInfo& AnimBone : AnimBones)
+		{
+			LinearChecksum += FindBoneIndexLinear(RefSkeleton, AnimBone.Name);
+		}
+	}
+	const double LinearSeconds = FPlatformTime::Seconds() - LinearStart;
+
+	TestEqual(TEXT("Map and linear lookups resolve the same indices"), MapChecksum, LinearChecksum);
+	AddInfo(FString::Printf(TEXT("Resolved %d bones x %d passes: map %.2f ms, linear %.2f ms (%.1fx)"),
+	                        AnimBones.Num(), NumTimingPasses, MapSeconds * 1000.0, LinearSeconds * 1000.0,
+	                        MapSeconds > 0.0 ? LinearSeconds / MapSeconds : 0.0));
+	TestTrue(TEXT("Map lookup is faster than linear lookup"), MapSeconds < LinearSeconds);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,120 @@
+﻿#include "Misc/AutomationTest.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Structures/SeModelSurface.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr uint32 NumBenchmarkVertices = 3'000'000;
+	constexpr uint32 NumBenchmarkFaces = NumBenchmarkVertices * 2;
+	constexpr uint8 NumBenchmarkInfluences = 4;
+	// 超过 0xFF 根骨骼，权重记录使用 2 字节骨骼索引
+	constexpr uint32 NumBenchmarkBones = 300;
+	constexpr int32 NumBenchmarkRuns = 5;
+
+	template <typename T>
+	void AppendValue(TArray64<uint8>& Buffer, const T& Value)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	// 按 FSeModelSurface 的读取顺序写出一个表面：头、顶点流、权重、面、材质
+	void BuildSurfaceBuffer(TArray64<uint8>& OutBuffer)
+	{
+		FRandomStream Random(0x5E30DE1);
+		OutBuffer.Reserve(16 + static_cast<int64>(NumBenchmarkVertices) * (12 + 8 + 12 + 4) +
+			static_cast<int64>(NumBenchmarkVertices) * NumBenchmarkInfluences * (sizeof(uint16) + sizeof(float)) +
+			static_cast<int64>(NumBenchmarkFaces) * 3 * sizeof(uint32) + sizeof(int32));
+
+		AppendValue<uint8>(OutBuffer, 0); // Flags
+		AppendValue<uint8>(OutBuffer, 1); // MaterialReferenceCount
+		AppendValue<uint8>(OutBuffer, NumBenchmarkInfluences);
+		AppendValue<uint32>(OutBuffer, NumBenchmarkVertices);
+		AppendValue<uint32>(OutBuffer, NumBenchmarkFaces);
+
+		for (uint32 i = 0; i < NumBenchmarkVertices; ++i)
+		{
+			AppendValue(OutBuffer, FVector3f(Random.FRandRange(-100.f, 100.f), Random.FRandRange(-100.f, 100.f),
+			                                 Random.FRandRange(-100.f, 100.f)));
+		}
+		for (uint32 i = 0; i < NumBenchmarkVertices; ++i)
+		{
+			AppendValue(OutBuffer, FVector2f(Random.FRand(), Random.FRand()));
+		}
+		for (uint32 i = 0; i < NumBenchmarkVertices; ++i)
+		{
+			AppendValue(OutBuffer, FVector3f(Random.GetUnitVector()));
+		}
+		for (uint32 i = 0; i < NumBenchmarkVertices; ++i)
+		{
+			AppendValue(OutBuffer, Random.GetUnsignedInt());
+		}
+		for (uint32 i = 0; i < NumBenchmarkVertices * NumBenchmarkInfluences; ++i)
+		{
+			AppendValue(OutBuffer, static_cast<uint16>(Random.RandHelper(NumBenchmarkBones)));
+			AppendValue(OutBuffer, Random.FRand());
+		}
+		// 顶点数超过 0xFFFF，面索引为 4 字节且不反转
+		for (uint32 i = 0; i < NumBenchmarkFaces * 3; ++i)
+		{
+			AppendValue(OutBuffer, static_cast<uint32>(Random.RandHelper(NumBenchmarkVertices)));
+		}
+		AppendValue<int32>(OutBuffer, 0);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSeModelSurfaceParseBenchmark, "IWToUE.SeModel.Surface.ParseVsMemcpy",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSeModelSurfaceParseBenchmark::RunTest(const FString& Parameters)
+{
+	TArray64<uint8> Buffer;
+	BuildSurfaceBuffer(Buffer);
+
+	// 两边都计入目标内存的分配，各取多次运行中最快的一次
+	double ParseSeconds = TNumericLimits<double>::Max();
+	double MemcpySeconds = TNumericLimits<double>::Max();
+	for (int32 Run = 0; Run < NumBenchmarkRuns; ++Run)
+	{
+		{
+			FLargeMemoryReader Reader(Buffer.GetData(), Buffer.Num());
+			const double Start = FPlatformTime::Seconds();
+			const FSeModelSurface Surface(Reader, NumBenchmarkBones, 0, 0);
+			ParseSeconds = FMath::Min(ParseSeconds, FPlatformTime::Seconds() - Start);
+
+			if (Run == 0)
+			{
+				TestFalse(TEXT("Reader has no error"), Reader.IsError());
+				TestEqual(TEXT("Reader consumed the whole buffer"), Reader.Tell(), Buffer.Num());
+				TestEqual(TEXT("Position count"), Surface.Positions.Num(), static_cast<int32>(NumBenchmarkVertices));
+				TestEqual(TEXT("Color count"), Surface.Colors.Num(), static_cast<int32>(NumBenchmarkVertices));
+				TestEqual(TEXT("Weight count"), Surface.Weights.Num(),
+				          static_cast<int32>(NumBenchmarkVertices * NumBenchmarkInfluences));
+				TestEqual(TEXT("Face count"), Surface.Faces.Num(), static_cast<int32>(NumBenchmarkFaces));
+				TestEqual(TEXT("Material count"), Surface.Materials.Num(), 1);
+				if (Surface.Weights.Num() > 0)
+				{
+					TestEqual(TEXT("Last weight vertex"), Surface.Weights.Last().VertexIndex, NumBenchmarkVertices - 1);
+				}
+			}
+		}
+		{
+			const double Start = FPlatformTime::Seconds();
+			TArray64<uint8> Copy;
+			Copy.SetNumUninitialized(Buffer.Num());
+			FMemory::Memcpy(Copy.GetData(), Buffer.GetData(), Buffer.Num());
+			MemcpySeconds = FMath::Min(MemcpySeconds, FPlatformTime::Seconds() - Start);
+		}
+	}
+
+	const double Ratio = MemcpySeconds > 0.0 ? ParseSeconds / MemcpySeconds : 0.0;
+	AddInfo(FString::Printf(TEXT("Parsed %u vertices / %u faces (%.1f MB): parse %.2f ms, memcpy %.2f ms (%.2fx)"),
+	                        NumBenchmarkVertices, NumBenchmarkFaces, Buffer.Num() / (1024.0 * 1024.0),
+	                        ParseSeconds * 1000.0, MemcpySeconds * 1000.0, Ratio));
+	TestTrue(TEXT("Surface parse is within 2x of memcpy"), Ratio <= 2.0);
+
+	return true;
+}
+
+#endif
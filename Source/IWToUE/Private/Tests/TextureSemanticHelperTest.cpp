@@ -0,0 +1,176 @@
+﻿#include "Misc/AutomationTest.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include "Utils/TextureSemanticHelper.h"
+#include "Widgets/CastImportUI.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using namespace TextureSemanticHelper;
+
+	struct FExpectedSemantic
+	{
+		const TCHAR* TextureType;
+		TextureCompressionSettings Compression;
+		bool bLinear;
+	};
+
+	// 与 TextureSemanticHelper.cpp 中的表逐项对应，修改表时需要同步更新
+	const FExpectedSemantic ExpectedSemantics[] = {
+		{TEXT("normalMap"), TC_Normalmap, false},
+		{TEXT("normalBodyMap"), TC_Normalmap, false},
+		{TEXT("detailMap"), TC_Normalmap, false},
+		{TEXT("detailMap1"), TC_Normalmap, false},
+		{TEXT("detailMap2"), TC_Normalmap, false},
+		{TEXT("detailNormal1"), TC_Normalmap, false},
+		{TEXT("detailNormal2"), TC_Normalmap, false},
+		{TEXT("detailNormal3"), TC_Normalmap, false},
+		{TEXT("detailNormal4"), TC_Normalmap, false},
+		{TEXT("transitionNormal"), TC_Normalmap, false},
+		{TEXT("flagRippleDetailMap"), TC_Normalmap, false},
+		{TEXT("distortionMap"), TC_Normalmap, false},
+		{TEXT("crackNormalMap"), TC_Normalmap, false},
+
+		{TEXT("aoMap"), TC_Grayscale, true},
+		{TEXT("alphaMaskMap"), TC_Grayscale, true},
+		{TEXT("alphaMask"), TC_Grayscale, true},
+		{TEXT("breakUpMap"), TC_Grayscale, true},
+		{TEXT("specularMask"), TC_Grayscale, true},
+		{TEXT("specularMaskDetail2"), TC_Grayscale, true},
+		{TEXT("tintMask"), TC_Grayscale, true},
+		{TEXT("tintBlendMask"), TC_Grayscale, true},
+		{TEXT("thicknessMap"), TC_Grayscale, true},
+		{TEXT("revealMap"), TC_Grayscale, true},
+		{TEXT("transRevealMap"), TC_Grayscale, true},
+		{TEXT("thermalHeatmap"), TC_Grayscale, true},
+		{TEXT("transGlossMap"), TC_Grayscale, true},
+		{TEXT("flickerLookupMap"), TC_Grayscale, true},
+		{TEXT("glossMap"), TC_Grayscale, true},
+		{TEXT("glossBodyMap"), TC_Grayscale, true},
+		{TEXT("glossMapDetail2"), TC_Grayscale, true},
+
+		{TEXT("customizeMask"), TC_Masks, false},
+		{TEXT("flowMap"), TC_Masks, false},
+		{TEXT("mixMap"), TC_Masks, false},
+		{TEXT("camoMaskMap"), TC_Masks, false},
+		{TEXT("detailNormalMask"), TC_Masks, false},
+
+		{TEXT("unk_semantic_0x9"), TC_Default, true},
+		{TEXT("unk_semantic_0xA"), TC_Default, true},
+		{TEXT("unk_semantic_0x4"), TC_Default, true},
+		{TEXT("unk_semantic_0x5"), TC_Default, true},
+		{TEXT("unk_semantic_0x58"), TC_Default, true},
+		{TEXT("unk_semantic_0x65"), TC_Default, true},
+	};
+
+	struct FExpectedRole
+	{
+		ECastMaterialType MaterialType;
+		const TCHAR* TextureType;
+		ETextureRole Role;
+	};
+
+	const FExpectedRole ExpectedRoles[] = {
+		{ECastMaterialType::CastMT_IW8, TEXT("unk_semantic_0x0"), ETextureRole::Metallic},
+		{ECastMaterialType::CastMT_IW8, TEXT("unk_semantic_0x4D"), ETextureRole::Skin},
+		{ECastMaterialType::CastMT_IW8, TEXT("unk_semantic_0x85"), ETextureRole::Hair},
+		{ECastMaterialType::CastMT_IW8, TEXT("unk_semantic_0x86"), ETextureRole::Eye},
+		{ECastMaterialType::CastMT_IW9, TEXT("unk_semantic_0x0"), ETextureRole::Metallic},
+		{ECastMaterialType::CastMT_T10, TEXT("unk_semantic_0x57"), ETextureRole::Metallic},
+	};
+
+	const ECastMaterialType AllMaterialTypes[] = {
+		ECastMaterialType::CastMT_T7,
+		ECastMaterialType::CastMT_IW8,
+		ECastMaterialType::CastMT_IW9,
+		ECastMaterialType::CastMT_T10,
+	};
+
+	ETextureRole GetExpectedRole(ECastMaterialType MaterialType, const FString& TextureType)
+	{
+		for (const FExpectedRole& Expected : ExpectedRoles)
+		{
+			if (Expected.MaterialType == MaterialType && TextureType == Expected.TextureType)
+			{
+				return Expected.Role;
+			}
+		}
+		return ETextureRole::None;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureSemanticTableTest, "IWToUE.TextureSemantic.SemanticTable",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTextureSemanticTableTest::RunTest(const FString& Parameters)
+{
+	for (const FExpectedSemantic& Expected : ExpectedSemantics)
+	{
+		const FString TextureType = Expected.TextureType;
+		// 查找不区分大小写
+		for (const FString& Query : {TextureType, TextureType.ToUpper(), TextureType.ToLower()})
+		{
+			const FTextureSemantic* Semantic = FindSemantic(Query);
+			if (!TestNotNull(*FString::Printf(TEXT("Semantic for %s"), *Query), Semantic))
+			{
+				continue;
+			}
+			TestEqual(*FString::Printf(TEXT("Compression of %s"), *Query),
+			          static_cast<int32>(Semantic->Compression), static_cast<int32>(Expected.Compression));
+			TestEqual(*FString::Printf(TEXT("Linear flag of %s"), *Query), Semantic->bLinear, Expected.bLinear);
+		}
+
+		UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage());
+		Texture->SRGB = true;
+		Texture->bFlipGreenChannel = true;
+		ApplySemantic(Texture, TextureType);
+		TestEqual(*FString::Printf(TEXT("Applied compression of %s"), *TextureType),
+		          static_cast<int32>(Texture->CompressionSettings.GetValue()), static_cast<int32>(Expected.Compression));
+		TestEqual(*FString::Printf(TEXT("Applied sRGB of %s"), *TextureType), Texture->SRGB != 0, !Expected.bLinear);
+		if (Expected.Compression == TC_Normalmap)
+		{
+			TestFalse(*FString::Printf(TEXT("Green channel flip of %s"), *TextureType), Texture->bFlipGreenChannel);
+		}
+		Texture->MarkAsGarbage();
+	}
+
+	for (const TCHAR* Unknown : {TEXT(""), TEXT("diffuseMap"), TEXT("unk_semantic_0x0"), TEXT("normalMapX")})
+	{
+		TestNull(*FString::Printf(TEXT("Semantic for unlisted type '%s'"), Unknown), FindSemantic(Unknown));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureSemanticRoleTest, "IWToUE.TextureSemantic.RoleTable",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTextureSemanticRoleTest::RunTest(const FString& Parameters)
+{
+	// 每个引擎都用所有已知的语义查询一遍，确保角色不会串到其它引擎的表里
+	TArray<FString> Queries{TEXT(""), TEXT("unk_semantic_0x1"), TEXT("normalMap")};
+	for (const FExpectedRole& Expected : ExpectedRoles)
+	{
+		Queries.AddUnique(Expected.TextureType);
+	}
+
+	for (const ECastMaterialType MaterialType : AllMaterialTypes)
+	{
+		for (const FString& TextureType : Queries)
+		{
+			const ETextureRole ExpectedRole = GetExpectedRole(MaterialType, TextureType);
+			for (const FString& Query : {TextureType, TextureType.ToLower()})
+			{
+				TestEqual(*FString::Printf(TEXT("Role of %s for material type %d"), *Query,
+				                           static_cast<int32>(MaterialType)),
+				          static_cast<int32>(FindRole(MaterialType, Query)), static_cast<int32>(ExpectedRole));
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,126 @@
+﻿#include "Utils/AnimResampleHelper.h"
+
+namespace
+{
+	/**
+	 * 所有重采样共用的关键帧遍历：第一个关键帧之前保持首值，帧号不递增的区间跳过，
+	 * 最后一个关键帧之后保持末值。每个区间只调用一次 FillSegment(Out, Start, End, Span, From, To)，
+	 * 写入 [Start, End) 帧，Span 为两个关键帧的帧距(End 可能被 NumFrames 截断)。
+	 */
+	template <typename T, typename FillSegmentFunc>
+	void WalkKeys(TArrayView<const uint32> KeyFrames, TArrayView<const T> KeyValues, TArrayView<T> OutValues,
+	              FillSegmentFunc FillSegment)
+	{
+		const int32 NumKeys = FMath::Min(KeyFrames.Num(), KeyValues.Num());
+		const int64 NumFrames = OutValues.Num();
+		if (NumKeys == 0 || NumFrames == 0) return;
+
+		T* Out = OutValues.GetData();
+
+		const int64 FirstFrame = FMath::Min<int64>(KeyFrames[0], NumFrames);
+		for (int64 Frame = 0; Frame < FirstFrame; ++Frame)
+		{
+			Out[Frame] = KeyValues[0];
+		}
+
+		for (int32 Key = 0; Key + 1 < NumKeys; ++Key)
+		{
+			const int64 Start = KeyFrames[Key];
+			if (Start >= NumFrames) break;
+			if (KeyFrames[Key + 1] <= KeyFrames[Key]) continue;
+
+			const int64 End = FMath::Min<int64>(KeyFrames[Key + 1], NumFrames);
+			FillSegment(Out, Start, End, KeyFrames[Key + 1] - Start, KeyValues[Key], KeyValues[Key + 1]);
+		}
+
+		for (int64 Frame = KeyFrames[NumKeys - 1]; Frame < NumFrames; ++Frame)
+		{
+			Out[Frame] = KeyValues[NumKeys - 1];
+		}
+	}
+
+	// 逐帧调用 Interpolate(From, To, Alpha) 的区间填充
+	template <typename InterpolateFunc>
+	auto MakePerFrameFill(InterpolateFunc Interpolate)
+	{
+		return [Interpolate](auto* Out, int64 Start, int64 End, int64 Span, const auto& From, const auto& To)
+		{
+			const float InvSpan = 1.f / static_cast<float>(Span);
+			for (int64 Frame = Start; Frame < End; ++Frame)
+			{
+				Out[Frame] = Interpolate(From, To, static_cast<float>(Frame - Start) * InvSpan);
+			}
+		};
+	}
+}
+
+void AnimResampleHelper::ResampleFloatTrack(TArrayView<const uint32> KeyFrames, TArrayView<const float> KeyValues,
+                                            TArrayView<float> OutValues)
+{
+	WalkKeys(KeyFrames, KeyValues, OutValues,
+	         [](float* Out, int64 Start, int64 End, int64 Span, float StartValue, float EndValue)
+	         {
+		         const float Step = (EndValue - StartValue) / static_cast<float>(Span);
+
+		         // 一次计算 4 帧：Value = Start + Step * Offset
+		         const VectorRegister4Float Four = VectorSetFloat1(4.f);
+		         const VectorRegister4Float StartVec = VectorSetFloat1(StartValue);
+		         const VectorRegister4Float StepVec = VectorSetFloat1(Step);
+		         VectorRegister4Float Offset = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+		         int64 Frame = Start;
+		         for (; Frame + 4 <= End; Frame += 4)
+		         {
+			         VectorStore(VectorMultiplyAdd(StepVec, Offset, StartVec), Out + Frame);
+			         Offset = VectorAdd(Offset, Four);
+		         }
+		         for (; Frame < End; ++Frame)
+		         {
+			         Out[Frame] = StartValue + Step * static_cast<float>(Frame - Start);
+		         }
+	         });
+}
+
+void AnimResampleHelper::ResampleQuatTrack(TArrayView<const uint32> KeyFrames, TArrayView<const FVector4f> KeyValues,
+                                           TArrayView<FVector4f> OutValues)
+{
+	WalkKeys(KeyFrames, KeyValues, OutValues,
+	         [](FVector4f* Out, int64 Start, int64 End, int64 Span, const FVector4f& FromValue,
+	            const FVector4f& ToValue)
+	         {
+		         const float InvSpan = 1.f / static_cast<float>(Span);
+		         const VectorRegister4Float From = VectorLoad(&FromValue.X);
+		         VectorRegister4Float To = VectorLoad(&ToValue.X);
+		         // 取最短路径
+		         if (VectorGetComponent(VectorDot4(From, To), 0) < 0.f)
+		         {
+			         To = VectorNegate(To);
+		         }
+		         const VectorRegister4Float Delta = VectorSubtract(To, From);
+
+		         for (int64 Frame = Start; Frame < End; ++Frame)
+		         {
+			         const VectorRegister4Float Alpha = VectorSetFloat1(static_cast<float>(Frame - Start) * InvSpan);
+			         VectorStore(VectorNormalize(VectorMultiplyAdd(Delta, Alpha, From)), &Out[Frame].X);
+		         }
+	         });
+}
+
+void AnimResampleHelper::ResampleVectorTrack(TArrayView<const uint32> KeyFrames,
+                                             TArrayView<const FVector3f> KeyValues, TArrayView<FVector3f> OutValues)
+{
+	WalkKeys(KeyFrames, KeyValues, OutValues, MakePerFrameFill(
+		         [](const FVector3f& From, const FVector3f& To, float Alpha)
+		         {
+			         return FMath::Lerp(From, To, Alpha);
+		         }));
+}
+
+void AnimResampleHelper::ResampleRotationTrack(TArrayView<const uint32> KeyFrames,
+                                               TArrayView<const FQuat4f> KeyValues, TArrayView<FQuat4f> OutValues)
+{
+	WalkKeys(KeyFrames, KeyValues, OutValues, MakePerFrameFill(
+		         [](const FQuat4f& From, const FQuat4f& To, float Alpha)
+		         {
+			         return FQuat4f::Slerp(From, To, Alpha);
+		         }));
+}
@@ -2,10 +2,23 @@
 
 void FBinaryReader::ReadString(FArchive& Ar, FString* OutText)
 {
-	char Ch;
-	while (Ar << Ch, Ch != 0)
+	// 按块读取后回退到结束符之后，避免逐字符反序列化
+	ANSICHAR Buffer[64];
+	while (!Ar.AtEnd() && !Ar.IsError())
 	{
-		OutText->AppendChar(Ch);
+		const int64 Start = Ar.Tell();
+		const int32 ReadSize = static_cast<int32>(FMath::Min<int64>(sizeof(Buffer), Ar.TotalSize() - Start));
+		Ar.Serialize(Buffer, ReadSize);
+
+		int32 Length = 0;
+		while (Length < ReadSize && Buffer[Length] != 0) ++Length;
+		OutText->AppendChars(Buffer, Length);
+
+		if (Length < ReadSize)
+		{
+			Ar.Seek(Start + Length + 1);
+			break;
+		}
 	}
 }
 
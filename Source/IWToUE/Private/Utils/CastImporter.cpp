@@ -25,12 +25,40 @@
 #include "Widgets/CastOptionWindow.h"
 #include "Windows/WindowsPlatformApplicationMisc.h"
 #include "FileHelpers.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeExit.h"
+#include "Utils/AnimResampleHelper.h"
+#include "Utils/MeshWeldHelper.h"
+#include "Utils/TextureSemanticHelper.h"
 #include "Factories/TextureFactory.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "Factories/CastSkeletalMeshImportData.h"
+#include "Factories/CastStaticMeshImportData.h"
 
 #define LOCTEXT_NAMESPACE "CastMainImport"
 
 TSharedPtr<FCastImporter> FCastImporter::StaticInstance;
 
+uint64 FCastImportOptions::GetHash() const
+{
+	// 哈希会保存在资产中，与 GetMaterialSignature 一样对规范化的 UTF-8 字符串做 CityHash64，
+	// 区分大小写且不依赖引擎版本的 GetTypeHash 实现
+	const uint32 Flags = bImportMaterial | bImportAsSkeletal << 1 | bImportMesh << 2 | bImportAnimations << 3 |
+		bImportAnimationNotify << 4 | bDeleteRootNodeAnim << 5 | bReverseFace << 6 | bConvertRefPosition << 7 |
+		bConvertRefAnim << 8 | bGenerateLightmapUVs << 9 | bWeldVertices << 10;
+	const FString Canonical = FString::Printf(
+		TEXT("M=%s\nF=%s\nS=%s\nP=%s\nB=%u\nT=%d\nA=%d\nMT=%d"),
+		*GlobalMaterialPath, *TextureFormat,
+		Skeleton ? *Skeleton->GetPathName() : TEXT(""),
+		PhysicsAsset ? *PhysicsAsset->GetPathName() : TEXT(""),
+		Flags, static_cast<int32>(TexturePathType), static_cast<int32>(AnimImportType),
+		static_cast<int32>(MaterialType));
+	const FTCHARToUTF8 Utf8Canonical(*Canonical);
+	return CityHash64(Utf8Canonical.Get(), Utf8Canonical.Length());
+}
+
 FCastImporter::FCastImporter()
 {
 	ImportOptions = new FCastImportOptions();
@@ -70,26 +98,26 @@ void FCastImporter::ReleaseScene()
 	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::ReleaseScene)
 
 	CreatedObjects.Empty();
+	HashedFilename.Empty();
 	CurPhase = NOTSTARTED;
 }
 
 int32 FCastImporter::GetImportType(const FString& InFilename)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::GetImportType);
+
 	int32 Result = -1;
-	FString Filename = InFilename;
 
-	if (OpenFile(Filename))
+	// 只扫描节点头，不做完整导入和 MD5，真正导入时再由 ImportFromFile 打开文件
+	if (FCastManager::ScanFile(InFilename, SceneInfo))
 	{
-		if (GetSceneInfo(Filename))
+		if (SceneInfo.SkinnedMeshNum > 0)
 		{
-			if (SceneInfo.SkinnedMeshNum > 0)
-			{
-				Result = 1;
-			}
-			else if (SceneInfo.TotalGeometryNum > 0)
-			{
-				Result = 0;
-			}
+			Result = 1;
+		}
+		else if (SceneInfo.TotalGeometryNum > 0)
+		{
+			Result = 0;
 		}
 
 		if (SceneInfo.bHasAnimation)
@@ -97,6 +125,10 @@ int32 FCastImporter::GetImportType(const FString& InFilename)
 			Result = 2;
 		}
 	}
+	else
+	{
+		UE_LOG(LogCast, Error, TEXT("Failed to scan cast file '%s'"), *InFilename);
+	}
 
 	return Result;
 }
@@ -128,7 +160,7 @@ bool FCastImporter::OpenFile(FString Filename)
 		return false;
 	}
 
-	Md5Hash = FMD5Hash::HashFile(*Filename);
+	GetSourceHash(Filename);
 
 	CurPhase = FILEOPENED;
 
@@ -162,18 +194,23 @@ bool FCastImporter::GetSceneInfo(FString Filename)
 
 	if (Result)
 	{
-		SceneInfo.TotalMaterialNum = CastManager->Scene->GetMaterialCount();
-		SceneInfo.TotalTextureNum = CastManager->Scene->GetTextureCount();
-		SceneInfo.bHasAnimation = CastManager->Scene->HasAnimation();
-		SceneInfo.FrameRate = CastManager->Scene->GetAnimFramerate();
-		SceneInfo.SkinnedMeshNum = CastManager->Scene->GetSkinnedMeshNum();
-		SceneInfo.TotalGeometryNum = CastManager->Scene->GetMeshNum();
+		UpdateSceneInfo();
 	}
 
 	GWarn->EndSlowTask();
 	return Result;
 }
 
+void FCastImporter::UpdateSceneInfo()
+{
+	SceneInfo.TotalMaterialNum = CastManager->Scene->GetMaterialCount();
+	SceneInfo.TotalTextureNum = CastManager->Scene->GetTextureCount();
+	SceneInfo.bHasAnimation = CastManager->Scene->HasAnimation();
+	SceneInfo.FrameRate = CastManager->Scene->GetAnimFramerate();
+	SceneInfo.SkinnedMeshNum = CastManager->Scene->GetSkinnedMeshNum();
+	SceneInfo.TotalGeometryNum = CastManager->Scene->GetMeshNum();
+}
+
 bool FCastImporter::ImportFile(FString Filename)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FFbxImporter::ImportFile);
@@ -223,6 +260,11 @@ bool FCastImporter::ImportFromFile(FString Filename)
 		}
 	case IMPORTED:
 		{
+			if (ImportOptions->bWeldVertices)
+			{
+				WeldMeshes();
+			}
+			UpdateSceneInfo();
 			CurPhase = FIXEDANDCONVERTED;
 			break;
 		}
@@ -234,166 +276,217 @@ bool FCastImporter::ImportFromFile(FString Filename)
 	return Result;
 }
 
+void FCastImporter::WeldMeshes()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::WeldMeshes);
+
+	TArray<FCastMeshInfo*> Meshes;
+	for (FCastRoot& Root : CastManager->Scene->Roots)
+	{
+		for (FCastModelInfo& Model : Root.Models)
+		{
+			// BlendShape 按顶点序号引用网格，合并后序号会失效
+			if (!Model.BlendShapes.IsEmpty())
+			{
+				continue;
+			}
+			for (FCastMeshInfo& Mesh : Model.Meshes)
+			{
+				Meshes.Add(&Mesh);
+			}
+		}
+	}
+
+	TArray<int32> NumRemoved;
+	NumRemoved.SetNumZeroed(Meshes.Num());
+	int32 NumVertices = 0;
+	for (const FCastMeshInfo* Mesh : Meshes)
+	{
+		NumVertices += Mesh->VertexPositions.Num();
+	}
+
+	ParallelFor(Meshes.Num(), [&](int32 Index)
+	{
+		NumRemoved[Index] = MeshWeldHelper::WeldVertices(*Meshes[Index]);
+	}, EParallelForFlags::Unbalanced);
+
+	int32 TotalRemoved = 0;
+	for (int32 Removed : NumRemoved)
+	{
+		TotalRemoved += Removed;
+	}
+	UE_LOG(LogCast, Log, TEXT("Welded %d of %d vertices (%.1f%% reduction)"), TotalRemoved, NumVertices,
+	       NumVertices > 0 ? 100.f * TotalRemoved / NumVertices : 0.f);
+}
+
+const FMD5Hash& FCastImporter::GetSourceHash(const FString& Filename)
+{
+	if (HashedFilename != Filename || !Md5Hash.IsValid())
+	{
+		Md5Hash = FMD5Hash::HashFile(*Filename);
+		HashedFilename = Filename;
+	}
+	return Md5Hash;
+}
+
+void FCastImporter::UpdateImportData(UCastAssetImportData* ImportData) const
+{
+	// 记录计算 Md5Hash 的文件，地图导入不经过 UFactory，GetCurrentFilename 不是当前文件
+	ImportData->UpdateCastSource(HashedFilename, Md5Hash, ImportOptions->GetHash());
+}
+
 void FCastImporter::AnalysisMaterial(const FString& ParentPath, FString MaterialPath, FString TexturePath,
                                      FString TextureFormat, bool bUseGlobalTexturePath)
 {
-	TArray<FCastRoot>& Roots = CastManager->Scene->Roots;
-	for (FCastRoot& Root : Roots)
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::AnalysisMaterial);
+
+	// 以材质描述文件的绝对路径(不含后缀)作为缓存键，共用的材质只解析一次
+	TArray<TPair<FCastMaterialInfo*, FString>> Materials;
+	TArray<FString> PendingKeys;
+	for (FCastRoot& Root : CastManager->Scene->Roots)
 	{
 		for (FCastModelInfo& Model : Root.Models)
 		{
 			for (FCastMaterialInfo& Material : Model.Materials)
 			{
-				// Parse Textures
-				FString TexturesFileName = FPaths::Combine(MaterialPath, Material.Name + "_images.txt");
-				if (TArray<FString> TextureContent;
-					FFileHelper::LoadFileToStringArray(TextureContent, *TexturesFileName))
+				FString Key = FPaths::ConvertRelativePathToFull(FPaths::Combine(MaterialPath, Material.Name));
+				if (!MaterialFileCache.Contains(Key))
 				{
-					for (int32 LineIndex = 1; LineIndex < TextureContent.Num(); ++LineIndex)
-					{
-						if (bUseGlobalTexturePath)
-						{
-							if (FCastTextureInfo CodTexture;
-								AnalysisTexture(CodTexture,
-								                ParentPath,
-								                TextureContent[LineIndex],
-								                TexturePath,
-								                TextureFormat))
-							{
-								Material.Textures.Add(CodTexture);
-							}
-						}
-						else
-						{
-							if (FCastTextureInfo CodTexture;
-								AnalysisTexture(CodTexture,
-								                ParentPath,
-								                TextureContent[LineIndex],
-								                FPaths::Combine(TexturePath, Material.Name),
-								                TextureFormat))
-							{
-								Material.Textures.Add(CodTexture);
-							}
-						}
-					}
+					PendingKeys.AddUnique(Key);
 				}
+				Materials.Emplace(&Material, MoveTemp(Key));
+			}
+		}
+	}
 
-				// Parse Settings
-				FString SettingsFileName = FPaths::Combine(MaterialPath, Material.Name + "_settings.txt");
-				if (TArray<FString> SettingsContent;
-					FFileHelper::LoadFileToStringArray(SettingsContent, *SettingsFileName))
-				{
-					TArray<FString> TechSetLineParts;
-					SettingsContent[1].ParseIntoArray(TechSetLineParts, TEXT(": "), false);
-					Material.TechSet = TechSetLineParts[1];
+	// 读取和解析放到工作线程，网络盘上打开文件的延迟也能重叠
+	TArray<TSharedPtr<const FCastMaterialFiles>> ParsedFiles;
+	ParsedFiles.SetNum(PendingKeys.Num());
+	ParallelFor(PendingKeys.Num(), [&](int32 Index)
+	{
+		ParsedFiles[Index] = ParseMaterialFiles(PendingKeys[Index] + TEXT("_images.txt"),
+		                                        PendingKeys[Index] + TEXT("_settings.txt"));
+	}, EParallelForFlags::Unbalanced);
+	for (int32 Index = 0; Index < PendingKeys.Num(); ++Index)
+	{
+		MaterialFileCache.Add(PendingKeys[Index], ParsedFiles[Index].ToSharedRef());
+	}
 
-					for (int32 LineIndex = 3; LineIndex < SettingsContent.Num(); ++LineIndex)
-					{
-						if (FCastSettingInfo CodSetting;
-							AnalysisSetting(CodSetting,
-								SettingsContent[LineIndex]))
-						{
-							Material.Settings.Add(CodSetting);
-						}
-					}
-				}
+	TArray<FCastTextureInfo> Textures;
+	TArray<FCastMaterialInfo*> TextureOwners;
+	for (const TPair<FCastMaterialInfo*, FString>& Entry : Materials)
+	{
+		FCastMaterialInfo& Material = *Entry.Key;
+		const FCastMaterialFiles& Files = *MaterialFileCache.FindChecked(Entry.Value);
+
+		const FString MaterialTexturePath = bUseGlobalTexturePath
+			                                    ? TexturePath
+			                                    : FPaths::Combine(TexturePath, Material.Name);
+		for (const FCastTextureInfo& ParsedTexture : Files.Textures)
+		{
+			FCastTextureInfo& CodTexture = Textures.Add_GetRef(ParsedTexture);
+			CodTexture.TexturePath = FPaths::Combine(MaterialTexturePath,
+			                                         CodTexture.TextureName + "." + TextureFormat);
+			TextureOwners.Add(&Material);
+		}
+
+		if (Files.bHasSettings)
+		{
+			Material.TechSet = Files.TechSet;
+			Material.Settings.Append(Files.Settings);
+		}
+	}
+
+	ImportTextures(Textures, ParentPath);
+	for (int32 Index = 0; Index < Textures.Num(); ++Index)
+	{
+		if (Textures[Index].TextureObject)
+		{
+			TextureOwners[Index]->Textures.Add(MoveTemp(Textures[Index]));
+		}
+	}
+}
+
+TSharedRef<const FCastImporter::FCastMaterialFiles> FCastImporter::ParseMaterialFiles(
+	const FString& TexturesFileName, const FString& SettingsFileName)
+{
+	TSharedRef<FCastMaterialFiles> Files = MakeShared<FCastMaterialFiles>();
+
+	// Parse Textures
+	if (TArray<FString> TextureContent;
+		FFileHelper::LoadFileToStringArray(TextureContent, *TexturesFileName))
+	{
+		for (int32 LineIndex = 1; LineIndex < TextureContent.Num(); ++LineIndex)
+		{
+			if (FCastTextureInfo CodTexture; AnalysisTexture(CodTexture, TextureContent[LineIndex]))
+			{
+				Files->Textures.Add(MoveTemp(CodTexture));
 			}
 		}
 	}
+
+	// Parse Settings
+	if (TArray<FString> SettingsContent;
+		FFileHelper::LoadFileToStringArray(SettingsContent, *SettingsFileName))
+	{
+		Files->bHasSettings = true;
+		if (SettingsContent.Num() > 1)
+		{
+			TArray<FString> TechSetLineParts;
+			SettingsContent[1].ParseIntoArray(TechSetLineParts, TEXT(": "), false);
+			if (TechSetLineParts.Num() > 1)
+			{
+				Files->TechSet = TechSetLineParts[1];
+			}
+		}
+
+		for (int32 LineIndex = 3; LineIndex < SettingsContent.Num(); ++LineIndex)
+		{
+			if (FCastSettingInfo CodSetting; AnalysisSetting(CodSetting, SettingsContent[LineIndex]))
+			{
+				Files->Settings.Add(MoveTemp(CodSetting));
+			}
+		}
+	}
+
+	return Files;
 }
 
-bool FCastImporter::AnalysisTexture(FCastTextureInfo& Texture, FString ParentPath, FString TextureLineText,
-                                    FString TexturePath, const FString& ImageFormat)
+void FCastImporter::ClearMaterialCaches()
+{
+	MaterialFileCache.Empty();
+
+	if (NumMaterialInstanceRequests > 0)
+	{
+		UE_LOG(LogCast, Log, TEXT("Material instances reused: %d/%d (%.1f%%)"), NumMaterialInstanceHits,
+		       NumMaterialInstanceRequests, 100.f * NumMaterialInstanceHits / NumMaterialInstanceRequests);
+	}
+	MaterialInstanceCache.Empty();
+	NumMaterialInstanceRequests = 0;
+	NumMaterialInstanceHits = 0;
+}
+
+bool FCastImporter::AnalysisTexture(FCastTextureInfo& Texture, const FString& TextureLineText)
 {
-	//if (ImportOptions->MaterialType == CastMT_IW9)
-	//{
-	//	TArray<FString> LineParts;
-	//	TextureLineText.ParseIntoArray(LineParts, TEXT(","), false);
-	//	FString TextureAddress = LineParts[0];
-	//	FString TextureName = LineParts[1];
-	//	Texture.TexturePath = FPaths::Combine(TexturePath, TextureName + "." + ImageFormat);
-	//	Texture.TextureName = TextureName;
-	//	Texture.TextureType = TEXT("Normal");
-
-	//	if (TextureName[0] == '$' || !FPaths::FileExists(Texture.TexturePath))
-	//	{
-	//		return false;
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x0" || TextureAddress == "unk_semantic_0x55")
-	//	{
-	//		Texture.TextureType = "Albedo";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x4" || TextureAddress == "unk_semantic_0x56")
-	//	{
-	//		Texture.TextureType = "NOG";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, false);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x8")
-	//	{
-	//		Texture.TextureType = "Emission";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0xC")
-	//	{
-	//		Texture.TextureType = "Alpha";
-	//		Texture.TextureType = "Alpha";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, false);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x22")
-	//	{
-	//		Texture.TextureType = "Transparency";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x26")
-	//	{
-	//		// TODO：SSS材质
-	//		Texture.TextureType = "Specular_Mask";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, false);
-	//	}
-	//	if (TextureAddress == "unk_semantic_0x32")
-	//	{
-	//		Texture.TextureType = "Mask";
-	//		return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
-	//	}
-	//}
-	//else if (ImportOptions->MaterialType == CastMT_IW8)
-	//{
-	//	TArray<FString> LineParts;
-	//	TextureLineText.ParseIntoArray(LineParts, TEXT(","), false);
-	//	FString TextureName = LineParts[1];
-	//	Texture.TexturePath = FPaths::Combine(TexturePath, TextureName + "." + ImageFormat);
-	//	Texture.TextureName = TextureName;
-	//	Texture.TextureType = LineParts[0];
-
-	//	return ImportTexture(Texture, Texture.TexturePath, ParentPath, false);
-	//}
-	//else if (ImportOptions->MaterialType == CastMT_T7)
-	//{
-	//	TArray<FString> LineParts;
-	//	TextureLineText.ParseIntoArray(LineParts, TEXT(","), false);
-	//	FString TextureName = LineParts[1];
-	//	Texture.TexturePath = FPaths::Combine(TexturePath, TextureName + "." + ImageFormat);
-	//	Texture.TextureName = TextureName;
-	//	Texture.TextureType = LineParts[0];
-
-	//	return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
-	//}
-	//return false;
 	TArray<FString> LineParts;
 	TextureLineText.ParseIntoArray(LineParts, TEXT(","), false);
-	FString TextureName = LineParts[1];
-	Texture.TexturePath = FPaths::Combine(TexturePath, TextureName + "." + ImageFormat);
-	Texture.TextureName = TextureName;
+	if (LineParts.Num() < 2)
+	{
+		return false;
+	}
+	Texture.TextureName = LineParts[1];
 	Texture.TextureType = LineParts[0];
-
-	return ImportTexture(Texture, Texture.TexturePath, ParentPath, true);
+	return true;
 }
 
-bool FCastImporter::AnalysisSetting(FCastSettingInfo& Setting, FString SettingLineText)
+bool FCastImporter::AnalysisSetting(FCastSettingInfo& Setting, const FString& SettingLineText)
 {
 	TArray<FString> LineParts;
 	SettingLineText.ParseIntoArray(LineParts, TEXT(","), false);
+	if (LineParts.Num() < 3)
+	{
+		return false;
+	}
 
 	// Setting Name
 	Setting.Name = LineParts[1];
@@ -408,8 +501,19 @@ bool FCastImporter::AnalysisSetting(FCastSettingInfo& Setting, FString SettingLi
 	};
 
 	const ESettingType* SettingType = TypeMap.Find(LineParts[0]);
+	if (!SettingType)
+	{
+		return false;
+	}
 	Setting.Type = *SettingType;
 
+	// 按 Color/Float4/Float3/Float2/Float1 的顺序
+	static constexpr int32 NumComponents[] = {4, 4, 3, 2, 1};
+	if (LineParts.Num() < 2 + NumComponents[Setting.Type])
+	{
+		return false;
+	}
+
 	switch (Setting.Type)
 	{
 	case Color:
@@ -460,22 +564,140 @@ bool FCastImporter::AnalysisSetting(FCastSettingInfo& Setting, FString SettingLi
 	return true;
 }
 
-bool FCastImporter::ImportTexture(FCastTextureInfo& Texture, const FString& FilePath, const FString& ParentPath,
-                                  bool bSRGB)
+FString FCastImporter::GetTextureAssetPath(const FString& FilePath, const FString& ParentPath)
 {
-
 	FString TexturePath = FPaths::Combine(*ParentPath, TEXT("Materials"), TEXT("Textures"),
 	                                      FPaths::GetCleanFilename(FPaths::GetPath(FilePath)));
 
-	FString DestinationTexturePath = FPaths::Combine(TexturePath, NoIllegalSigns(FPaths::GetBaseFilename(FilePath)));
+	return FPaths::Combine(TexturePath, NoIllegalSigns(FPaths::GetBaseFilename(FilePath)));
+}
+
+void FCastImporter::ImportTextures(TArrayView<FCastTextureInfo> Textures, const FString& ParentPath)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::ImportTextures);
+
+	// 同一个目标资产只导入一次，已存在的资产直接加载
+	struct FTextureJob
+	{
+		FString AssetPath;
+		FString FilePath;
+		FString TextureType;
+		UTexture2D* Result{nullptr};
+	};
+	TArray<FTextureJob> Jobs;
+	TMap<FString, int32> JobByAssetPath;
+	TArray<int32> TextureJobs;
+	TextureJobs.Init(INDEX_NONE, Textures.Num());
+	for (int32 Index = 0; Index < Textures.Num(); ++Index)
+	{
+		FCastTextureInfo& Texture = Textures[Index];
+		FString AssetPath = GetTextureAssetPath(Texture.TexturePath, ParentPath);
+		if (const int32* JobIndex = JobByAssetPath.Find(AssetPath))
+		{
+			TextureJobs[Index] = *JobIndex;
+			continue;
+		}
+		if (UTexture2D* LoadedTexture = LoadObject<UTexture2D>(nullptr, *AssetPath, nullptr,
+		                                                       LOAD_NoWarn | LOAD_Quiet))
+		{
+			Texture.TextureObject = LoadedTexture;
+			continue;
+		}
+
+		const int32 JobIndex = Jobs.Num();
+		FTextureJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.AssetPath = AssetPath;
+		Job.FilePath = Texture.TexturePath;
+		Job.TextureType = Texture.TextureType;
+		JobByAssetPath.Add(MoveTemp(AssetPath), JobIndex);
+		TextureJobs[Index] = JobIndex;
+	}
+
+	// 分块处理，同一时间只保留一块的解码结果，避免整批贴图的 FImage 同时驻留内存
+	const int32 ChunkSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads()) * 4;
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+	TArray<FImage> Images;
+	TArray<bool> Decoded;
+	TArray<UPackage*> PackagesToSave;
+	for (int32 ChunkStart = 0; ChunkStart < Jobs.Num(); ChunkStart += ChunkSize)
+	{
+		const int32 ChunkNum = FMath::Min(ChunkSize, Jobs.Num() - ChunkStart);
+		Images.SetNum(ChunkNum);
+		Decoded.Init(false, ChunkNum);
+
+		// 读取和解码在工作线程进行
+		ParallelFor(ChunkNum, [&](int32 ChunkIndex)
+		{
+			TArray64<uint8> FileData;
+			if (FFileHelper::LoadFileToArray(FileData, *Jobs[ChunkStart + ChunkIndex].FilePath, FILEREAD_Silent))
+			{
+				Decoded[ChunkIndex] = ImageWrapperModule.DecompressImage(FileData.GetData(), FileData.Num(),
+				                                                         Images[ChunkIndex]);
+			}
+		}, EParallelForFlags::Unbalanced);
+
+		// UObject 的创建在游戏线程进行，ImageWrapper 不支持的格式交给 UTextureFactory
+		for (int32 ChunkIndex = 0; ChunkIndex < ChunkNum; ++ChunkIndex)
+		{
+			FTextureJob& Job = Jobs[ChunkStart + ChunkIndex];
+			UTexture2D* Texture = Decoded[ChunkIndex]
+				                      ? CreateTextureFromImage(Job.AssetPath, Job.FilePath, Images[ChunkIndex])
+				                      : ImportTextureWithFactory(Job.AssetPath, Job.FilePath);
+			Images[ChunkIndex] = FImage();
+			if (Texture && ApplyTextureSettings(Texture, Job.TextureType))
+			{
+				Job.Result = Texture;
+				PackagesToSave.Add(Texture->GetPackage());
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < Textures.Num(); ++Index)
+	{
+		if (TextureJobs[Index] != INDEX_NONE)
+		{
+			Textures[Index].TextureObject = Jobs[TextureJobs[Index]].Result;
+		}
+	}
+
+	if (!PackagesToSave.IsEmpty())
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+	}
+}
+
+bool FCastImporter::ImportTexture(FCastTextureInfo& Texture, const FString& FilePath, const FString& ParentPath,
+                                  bool bSRGB)
+{
+	Texture.TexturePath = FilePath;
+	ImportTextures(MakeArrayView(&Texture, 1), ParentPath);
+	return Texture.TextureObject != nullptr;
+}
 
-	FString AssetPath = DestinationTexturePath;
-	if (UTexture2D* LoadedTexture = LoadObject<UTexture2D>(nullptr, *AssetPath))
+UTexture2D* FCastImporter::CreateTextureFromImage(const FString& AssetPath, const FString& FilePath,
+                                                  const FImage& Image)
+{
+	UPackage* Package = CreatePackage(*AssetPath);
+	Package->FullyLoad();
+	UTexture2D* Texture = NewObject<UTexture2D>(Package, FName(FPackageName::GetShortName(AssetPath)),
+	                                            RF_Standalone | RF_Public);
+	Texture->Source.Init(Image);
+	if (ERawImageFormat::IsHDR(Image.Format))
+	{
+		Texture->CompressionSettings = TC_HDR;
+		Texture->SRGB = false;
+	}
+	else if (Image.Format == ERawImageFormat::G8 || Image.Format == ERawImageFormat::G16)
 	{
-		Texture.TextureObject = LoadedTexture;
-		return true;
+		Texture->CompressionSettings = TC_Grayscale;
 	}
+	Texture->AssetImportData->Update(FilePath);
+	FAssetRegistryModule::AssetCreated(Texture);
+	return Texture;
+}
 
+UTexture2D* FCastImporter::ImportTextureWithFactory(const FString& AssetPath, const FString& FilePath)
+{
 	// Create the texture factory
 	UTextureFactory* TextureFactory = NewObject<UTextureFactory>();
 	TextureFactory->SuppressImportOverwriteDialog();
@@ -483,97 +705,32 @@ bool FCastImporter::ImportTexture(FCastTextureInfo& Texture, const FString& File
 	bool bOutOperationCanceled = false;
 	// Create the parent package
 	UPackage* Package = CreatePackage(*AssetPath);
-	UTexture2D* ImportedTexture = (UTexture2D*)TextureFactory->FactoryCreateFile(
+	return (UTexture2D*)TextureFactory->FactoryCreateFile(
 		UTexture2D::StaticClass(),
 		Package,
-		FName(NoIllegalSigns(*FPaths::GetBaseFilename(FilePath))),
+		FName(FPackageName::GetShortName(AssetPath)),
 		RF_Standalone | RF_Public,
 		FilePath,
-		nullptr,  // Parms
+		nullptr, // Parms
 		GWarn,
 		bOutOperationCanceled
 	);
+}
 
-	if (ImportedTexture)
-	{
-		if (ImportedTexture->GetSizeX() < 2 && ImportedTexture->GetSizeY() < 2) return false;
-
-		ImportedTexture->PreEditChange(nullptr);
-		ImportedTexture->GetPackage()->FullyLoad();
-		ImportedTexture->GetPackage()->Modify();
-
-		// Apply settings based on TextureType
-		if (Texture.TextureType == "normalMap" ||
-			Texture.TextureType == "normalBodyMap" ||
-			Texture.TextureType == "detailMap" ||
-			Texture.TextureType == "detailMap1" ||
-			Texture.TextureType == "detailMap2" ||
-			Texture.TextureType == "detailNormal1" ||
-			Texture.TextureType == "detailNormal2" ||
-			Texture.TextureType == "detailNormal3" ||
-			Texture.TextureType == "detailNormal4" ||
-			Texture.TextureType == "transitionNormal" ||
-			Texture.TextureType == "flagRippleDetailMap" ||
-			Texture.TextureType == "distortionMap" ||
-			Texture.TextureType == "crackNormalMap")
-		{
-			ImportedTexture->CompressionSettings = TC_Normalmap;
-			ImportedTexture->bFlipGreenChannel = false;
-		}
-
-		else if (Texture.TextureType == "aoMap" ||
-			Texture.TextureType == "alphaMaskMap" ||
-			Texture.TextureType == "alphaMask" ||
-			Texture.TextureType == "breakUpMap" ||
-			Texture.TextureType == "specularMask" ||
-			Texture.TextureType == "specularMaskDetail2" ||
-			Texture.TextureType == "tintMask" ||
-			Texture.TextureType == "tintBlendMask" ||
-			Texture.TextureType == "thicknessMap" ||
-			Texture.TextureType == "revealMap" ||
-			Texture.TextureType == "transRevealMap" ||
-			Texture.TextureType == "thermalHeatmap" ||
-			Texture.TextureType == "transGlossMap" ||
-			Texture.TextureType == "flickerLookupMap" ||
-			Texture.TextureType == "glossMap" ||
-			Texture.TextureType == "glossBodyMap" ||
-			Texture.TextureType == "glossMapDetail2")
-		{
-			ImportedTexture->CompressionSettings = TC_Grayscale;
-			ImportedTexture->SRGB = false;
-		}
+bool FCastImporter::ApplyTextureSettings(UTexture2D* Texture, const FString& TextureType)
+{
+	if (Texture->Source.GetSizeX() < 2 && Texture->Source.GetSizeY() < 2) return false;
 
-		else if (Texture.TextureType == "customizeMask" ||
-			Texture.TextureType == "flowMap" ||
-			Texture.TextureType == "mixMap" ||
-			Texture.TextureType == "camoMaskMap" ||
-			Texture.TextureType == "detailNormalMask")
-		{
-			ImportedTexture->CompressionSettings = TC_Masks;
-		}
-		    // IW8
-		else if (Texture.TextureType == "unk_semantic_0x9" ||
-			Texture.TextureType == "unk_semantic_0xA" ||
-			// IW9/JUP
-			Texture.TextureType == "unk_semantic_0x4" || 
-			Texture.TextureType == "unk_semantic_0x5" || 
-			// T10
-			Texture.TextureType == "unk_semantic_0x58" || 
-			Texture.TextureType == "unk_semantic_0x65")
-		{
-			ImportedTexture->CompressionSettings = TC_Default;
-			ImportedTexture->SRGB = false;
-		}
+	Texture->PreEditChange(nullptr);
+	Texture->GetPackage()->FullyLoad();
+	Texture->GetPackage()->Modify();
 
-		ImportedTexture->PostEditChange();
-		ImportedTexture->UpdateResource();
-		ImportedTexture->MarkPackageDirty();
-		UEditorLoadingAndSavingUtils::SavePackages(TArray<UPackage*>{ImportedTexture->GetPackage()}, false);
-		Texture.TextureObject = ImportedTexture;
-		return true;
-	}
+	TextureSemanticHelper::ApplySemantic(Texture, TextureType);
 
-	return false;
+	Texture->PostEditChange();
+	Texture->UpdateResource();
+	Texture->MarkPackageDirty();
+	return true;
 }
 
 UMaterialInterface* FCastImporter::CreateMaterialInstance(const FCastMaterialInfo& Material,
@@ -584,114 +741,64 @@ UMaterialInterface* FCastImporter::CreateMaterialInstance(const FCastMaterialInf
 	FString MaterialType = TEXT("Base");
 	bool isMetallic = false;
 	bool isHead = false;
-	const auto MaterialInstanceFactory = NewObject<UMaterialInstanceConstantFactoryNew>();
 
 	FString MaterialPath;
 	if (ImportOptions->MaterialType == ECastMaterialType::CastMT_T7)
 	{
 		MaterialPath = FPaths::Combine("/UGC4579750/black_ops_2/Shading/T7/TechSets", Material.TechSet);
 	}
-	if (ImportOptions->MaterialType == ECastMaterialType::CastMT_IW8)
+	else
 	{
-		for (const auto Texture : Material.Textures)
+		for (const FCastTextureInfo& Texture : Material.Textures)
 		{
-			// Check if metallic
-			if (Texture.TextureType == TEXT("unk_semantic_0x0"))
+			switch (TextureSemanticHelper::FindRole(ImportOptions->MaterialType, Texture.TextureType))
 			{
+			case TextureSemanticHelper::ETextureRole::Metallic:
+				// Check if metallic
 				if (Texture.TextureObject->HasAlphaChannel())
 				{
 					isMetallic = true;
 				}
-			}
-			// Check if Skin
-			if (Texture.TextureType == TEXT("unk_semantic_0x4D"))
-			{
+				break;
+			case TextureSemanticHelper::ETextureRole::Skin:
 				MaterialType = TEXT("Skin");
-				// Check if Head
-				//if (Texture.TextureType == TEXT("unk_semantic_0x7F"))
-				//	isHead = true;
-			}
-			// Check if Hair
-			if (Texture.TextureType == TEXT("unk_semantic_0x85"))
-			{
+				break;
+			case TextureSemanticHelper::ETextureRole::Hair:
 				MaterialType = TEXT("Hair");
-			}
-			// Check if Eye
-			if (Texture.TextureType == TEXT("unk_semantic_0x86"))
-			{
+				break;
+			case TextureSemanticHelper::ETextureRole::Eye:
 				MaterialType = TEXT("Eye");
+				break;
+			default: break;
 			}
 		}
-		MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/IW8", "IW8_" + MaterialType);
-	}
-	if (ImportOptions->MaterialType == ECastMaterialType::CastMT_IW9)
-	{
-		for (const auto Texture : Material.Textures)
+
+		if (ImportOptions->MaterialType == ECastMaterialType::CastMT_IW8)
 		{
-			// Check if metallic
-			if (Texture.TextureType == TEXT("unk_semantic_0x0"))
-			{
-				if (Texture.TextureObject->HasAlphaChannel())
-				{
-					isMetallic = true;
-				}
-			}
-			//// Check if Skin
-			// if (Texture.TextureType == TEXT("unk_semantic_0x26"))
-			// {
-			// 	 if (Texture.TextureName != "$black" && Texture.TextureName != "$white")
-			// 	 	MaterialType = TEXT("Skin");
-			// 	//Check if Head
-			// 	if (Texture.TextureType == TEXT("unk_semantic_0x7F"))
-			// 		isHead = true;
-			// }
-			//// Check if Hair
-			// if (Texture.TextureType == TEXT("unk_semantic_0x85"))
-			// {
-			// 	MaterialType = TEXT("Hair");
-			// }
-			//// Check if Eye
-			// if (Texture.TextureType == TEXT("unk_semantic_0x86"))
-			// {
-			// 	MaterialType = TEXT("Eye");
-			// }
+			MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/IW8", "IW8_" + MaterialType);
+		}
+		else if (ImportOptions->MaterialType == ECastMaterialType::CastMT_IW9)
+		{
+			MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/IW9", "IW9_" + MaterialType);
+		}
+		else if (ImportOptions->MaterialType == ECastMaterialType::CastMT_T10)
+		{
+			MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/T10", "T10_" + MaterialType);
 		}
-		MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/IW9", "IW9_" + MaterialType);
 	}
-	if (ImportOptions->MaterialType == ECastMaterialType::CastMT_T10)
+
+	++NumMaterialInstanceRequests;
+	const uint64 Signature = GetMaterialSignature(Material, MaterialPath, isMetallic);
+	if (const TWeakObjectPtr<UMaterialInterface>* CachedInstance = MaterialInstanceCache.Find(Signature))
 	{
-		for (const auto Texture : Material.Textures)
+		if (UMaterialInterface* CachedMaterial = CachedInstance->Get())
 		{
-			// Check if metallic
-			if (Texture.TextureType == TEXT("unk_semantic_0x57"))
-			{
-				if (Texture.TextureObject->HasAlphaChannel())
-				{
-					isMetallic = true;
-				}
-			}
-			// // Check if Skin
-			// if (Texture.TextureType == TEXT("unk_semantic_0x4D"))
-			// {
-			// 	MaterialType = TEXT("Skin");
-			// 	// Check if Head
-			// 	if (Texture.TextureType == TEXT("unk_semantic_0x7F"))
-			// 		isHead = true;
-			// }
-			// // Check if Hair
-			// if (Texture.TextureType == TEXT("unk_semantic_0x85"))
-			// {
-			// 	MaterialType = TEXT("Hair");
-			// }
-			// // Check if Eye
-			// if (Texture.TextureType == TEXT("unk_semantic_0x86"))
-			// {
-			// 	MaterialType = TEXT("Eye");
-			// }
+			++NumMaterialInstanceHits;
+			return CachedMaterial;
 		}
-		MaterialPath = FPaths::Combine("/IWToUE/Shading/IW/T10", "T10_" + MaterialType);
 	}
 
+	const auto MaterialInstanceFactory = NewObject<UMaterialInstanceConstantFactoryNew>();
 	MaterialInstanceFactory->InitialParent =
 		Cast<UMaterial>(StaticLoadObject(UMaterial::StaticClass(), nullptr, *MaterialPath));
 	const auto MaterialPackage = CreatePackage(
@@ -769,9 +876,43 @@ UMaterialInterface* FCastImporter::CreateMaterialInstance(const FCastMaterialInf
 	UnrealMaterialFinal->GetPackage()->FullyLoad();
 	UnrealMaterialFinal->MarkPackageDirty();
 
+	MaterialInstanceCache.Add(Signature, UnrealMaterialFinal);
 	return UnrealMaterialFinal;
 }
 
+uint64 FCastImporter::GetMaterialSignature(const FCastMaterialInfo& Material, const FString& ParentMaterialPath,
+                                           bool bMetallic)
+{
+	// 参数顺序不影响结果，排序后拼接成规范字符串再哈希
+	TArray<FString> Parameters;
+	Parameters.Reserve(Material.Textures.Num() + Material.Settings.Num());
+	for (const FCastTextureInfo& Texture : Material.Textures)
+	{
+		if (Texture.TextureObject && !Texture.TextureType.IsEmpty())
+		{
+			Parameters.Add(FString::Printf(TEXT("T|%s|%s"), *Texture.TextureType,
+			                               *Texture.TextureObject->GetPathName()));
+		}
+	}
+	for (const FCastSettingInfo& Setting : Material.Settings)
+	{
+		Parameters.Add(FString::Printf(TEXT("S|%s|%d|%.9g|%.9g|%.9g|%.9g"), *Setting.Name,
+		                               static_cast<int32>(Setting.Type), Setting.Value.X, Setting.Value.Y,
+		                               Setting.Value.Z, Setting.Value.W));
+	}
+	Parameters.Sort();
+
+	FString Signature = ParentMaterialPath;
+	Signature += bMetallic ? TEXT("|M") : TEXT("|D");
+	for (const FString& Parameter : Parameters)
+	{
+		Signature += TEXT('\n');
+		Signature += Parameter;
+	}
+	const FTCHARToUTF8 Utf8Signature(*Signature);
+	return CityHash64(Utf8Signature.Get(), Utf8Signature.Length());
+}
+
 void FCastImporter::ClearAllCaches()
 {
 }
@@ -876,21 +1017,7 @@ FCastImportOptions* FCastImporter::GetImportOptions(
 		);
 		FSlateApplication::Get().AddModalWindow(Window, ParentWindow, false);
 
-		ImportOptions->PhysicsAsset = ImportUI->PhysicsAsset;
-		ImportOptions->Skeleton = ImportUI->Skeleton;
-		ImportOptions->bImportMaterial = ImportUI->bMaterials;
-		ImportOptions->TexturePathType = ImportUI->TexturePathType;
-		ImportOptions->GlobalMaterialPath = ImportUI->GlobalMaterialPath;
-		ImportOptions->TextureFormat = ImportUI->TextureFormat;
-		ImportOptions->bImportAsSkeletal = ImportUI->bImportAsSkeletal;
-		ImportOptions->bImportMesh = ImportUI->bImportMesh;
-		ImportOptions->bImportAnimations = ImportUI->bImportAnimations;
-		ImportOptions->bConvertRefPosition = ImportUI->bConvertRefPosition;
-		ImportOptions->bConvertRefAnim = ImportUI->bConvertRefAnim;
-		ImportOptions->bReverseFace = ImportUI->bReverseFace;
-		ImportOptions->bImportAnimationNotify = ImportUI->bImportAnimationNotify;
-		ImportOptions->bDeleteRootNodeAnim = ImportUI->bDeleteRootNodeAnim;
-		ImportOptions->MaterialType = ImportUI->MaterialType;
+		ApplyImportUI(ImportUI, *ImportOptions);
 
 		if (CastOptionWindow->ShouldImport())
 		{
@@ -902,6 +1029,27 @@ FCastImportOptions* FCastImporter::GetImportOptions(
 	return ImportOptions;
 }
 
+void FCastImporter::ApplyImportUI(const UCastImportUI* ImportUI, FCastImportOptions& OutOptions)
+{
+	OutOptions.PhysicsAsset = ImportUI->PhysicsAsset;
+	OutOptions.Skeleton = ImportUI->Skeleton;
+	OutOptions.bImportMaterial = ImportUI->bMaterials;
+	OutOptions.TexturePathType = ImportUI->TexturePathType;
+	OutOptions.GlobalMaterialPath = ImportUI->GlobalMaterialPath;
+	OutOptions.TextureFormat = ImportUI->TextureFormat;
+	OutOptions.bImportAsSkeletal = ImportUI->bImportAsSkeletal;
+	OutOptions.bImportMesh = ImportUI->bImportMesh;
+	OutOptions.bImportAnimations = ImportUI->bImportAnimations;
+	OutOptions.bConvertRefPosition = ImportUI->bConvertRefPosition;
+	OutOptions.bConvertRefAnim = ImportUI->bConvertRefAnim;
+	OutOptions.bReverseFace = ImportUI->bReverseFace;
+	OutOptions.bGenerateLightmapUVs = ImportUI->bGenerateLightmapUVs;
+	OutOptions.bWeldVertices = ImportUI->bWeldVertices;
+	OutOptions.bImportAnimationNotify = ImportUI->bImportAnimationNotify;
+	OutOptions.bDeleteRootNodeAnim = ImportUI->bDeleteRootNodeAnim;
+	OutOptions.MaterialType = ImportUI->MaterialType;
+}
+
 USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshArgs& ImportSkeletalMeshArgs)
 {
 	FScopedSlowTask SlowTask(1);
@@ -967,34 +1115,12 @@ USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshA
 				}
 			}
 		}
-		// 顶点
-		Data.Points.Empty();
-		for (FCastRoot& Root : CastManager->Scene->Roots)
-		{
-			for (FCastModelInfo& Model : Root.Models)
-			{
-				for (FCastMeshInfo& Mesh : Model.Meshes)
-				{
-					for (int32 i = 0; i < Mesh.VertexPositions.Num(); ++i)
-					{
-						Data.Points.Add(FVector3f(Mesh.VertexPositions[i].X,
-						                          -Mesh.VertexPositions[i].Y,
-						                          Mesh.VertexPositions[i].Z));
-					}
-				}
-			}
-		}
-
 		// 一般是两个UV层，第一个是正常UV，第二个是光照贴图
 		// 可以支持更多UV层，暂时还没发现这样的cast文件
 		Data.NumTexCoords = 2;
-		// 面 和 材质
-		int32 VertexOffset = 0;
-		TArray<int32> VertexOrder = {0, 1, 2};
-		if (ImportOptions->bReverseFace)
-		{
-			VertexOrder = {2, 1, 0};
-		}
+		// 先串行分配材质，几何数据之后按网格并行填充
+		TArray<FCastMeshSlice> MeshSlices;
+		int32 BoneOffset = 0;
 		TMap<uint32, int32> DataMatMap;
 		for (FCastRoot& Root : CastManager->Scene->Roots)
 		{
@@ -1022,64 +1148,7 @@ USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshA
 						DataMatMap.Add(ModelMatIdx, MatIdx);
 					}
 
-					const int32 MeshFaceCnt = Mesh.Faces.Num() / 3;
-					for (int32 FaceID = 0; FaceID < MeshFaceCnt; ++FaceID)
-					{
-						SkeletalMeshImportData::FTriangle& Triangle = Data.Faces.AddZeroed_GetRef();
-						Triangle.SmoothingGroups = 255;
-						uint32 TriangleVertexID[3] = {
-							Mesh.Faces[FaceID * 3], Mesh.Faces[FaceID * 3 + 1], Mesh.Faces[FaceID * 3 + 2]
-						};
-						for (int32 FaceVertexID = 0; FaceVertexID < 3; ++FaceVertexID)
-						{
-							int32 WedgesID = Data.Wedges.AddUninitialized();
-							SkeletalMeshImportData::FVertex& Wedges = Data.Wedges[WedgesID];
-
-							const int32 MeshVertexID = TriangleVertexID[VertexOrder[FaceVertexID]];
-							Wedges.MatIndex = MatIdx;
-							Wedges.VertexIndex = MeshVertexID + VertexOffset;
-							if (Mesh.VertexColor.IsValidIndex(MeshVertexID))
-							{
-								Wedges.Color = FColor((Mesh.VertexColor[MeshVertexID] >> 0) & 0xFF,
-								                      (Mesh.VertexColor[MeshVertexID] >> 8) & 0xFF,
-								                      (Mesh.VertexColor[MeshVertexID] >> 16) & 0xFF,
-								                      (Mesh.VertexColor[MeshVertexID] >> 24) & 0xFF);
-							}
-							Wedges.UVs[0] = FVector2f(Mesh.VertexUV[MeshVertexID].X, Mesh.VertexUV[MeshVertexID].Y);
-							Wedges.Reserved = 0;
-
-							Triangle.TangentZ[FaceVertexID] = FVector3f{
-								Mesh.VertexNormals[MeshVertexID].X,
-								-Mesh.VertexNormals[MeshVertexID].Y,
-								Mesh.VertexNormals[MeshVertexID].Z
-							};
-							Triangle.TangentZ->Normalize();
-							Triangle.WedgeIndex[FaceVertexID] = WedgesID;
-						}
-						Triangle.MatIndex = MatIdx;
-					}
-					VertexOffset += Mesh.VertexPositions.Num();
-				}
-			}
-		}
-
-		// 权重
-		VertexOffset = 0;
-		int32 BoneOffset = 0;
-		for (FCastRoot& Root : CastManager->Scene->Roots)
-		{
-			for (FCastModelInfo& Model : Root.Models)
-			{
-				for (FCastMeshInfo& Mesh : Model.Meshes)
-				{
-					for (uint32 WightID = 0; WightID < (uint32)Mesh.VertexWeightBone.Num(); ++WightID)
-					{
-						Data.Influences.AddUninitialized();
-						Data.Influences.Last().VertexIndex = (int32)(WightID / Mesh.MaxWeight) + VertexOffset;
-						Data.Influences.Last().BoneIndex = Mesh.VertexWeightBone[WightID] + BoneOffset;
-						Data.Influences.Last().Weight = Mesh.VertexWeightValue[WightID];
-					}
-					VertexOffset += Mesh.VertexPositions.Num();
+					MeshSlices.Add({&Mesh, MatIdx, BoneOffset});
 				}
 				for (FCastSkeletonInfo& Skeleton : Model.Skeletons)
 				{
@@ -1087,6 +1156,8 @@ USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshA
 				}
 			}
 		}
+
+		FillSkeletalMeshGeometry(Data, MeshSlices, ImportOptions->bReverseFace);
 	}
 
 	FSkeletalMeshBuildSettings BuildOptions;
@@ -1181,8 +1252,11 @@ USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshA
 		SkeletalMesh->MarkAsGarbage();
 		return NULL;
 	}
-	SkeletalMesh->GetAssetImportData()->AddFileName(UFactory::GetCurrentFilename(), 0,
-	                                                NSSkeletalMeshSourceFileLabels::GeoAndSkinningText().ToString());
+	UCastSkeletalMeshImportData* ImportData =
+		UCastSkeletalMeshImportData::GetImportDataForSkeletalMesh(SkeletalMesh, nullptr);
+	UpdateImportData(ImportData);
+	ImportData->SourceData.SourceFiles[0].DisplayLabelName =
+		NSSkeletalMeshSourceFileLabels::GeoAndSkinningText().ToString();
 	SkeletalMesh->CalculateInvRefMatrices();
 	if (!SkeletalMesh->GetResourceForRendering()
 		|| !SkeletalMesh->GetResourceForRendering()->LODRenderData.IsValidIndex(0))
@@ -1227,6 +1301,105 @@ USkeletalMesh* FCastImporter::ImportSkeletalMesh(CastScene::FImportSkeletalMeshA
 	return SkeletalMesh;
 }
 
+void FCastImporter::FillSkeletalMeshGeometry(FSkeletalMeshImportData& Data, TArrayView<const FCastMeshSlice> Slices,
+                                             bool bReverseFace, bool bParallel)
+{
+	int32 VertexOrder[3] = {0, 1, 2};
+	if (bReverseFace)
+	{
+		VertexOrder[0] = 2;
+		VertexOrder[2] = 0;
+	}
+
+	// 每个网格在各数组中的起始位置
+	struct FSliceOffsets
+	{
+		int32 VertexOffset;
+		int32 FaceOffset;
+		int32 InfluenceOffset;
+	};
+	TArray<FSliceOffsets> Offsets;
+	Offsets.SetNumUninitialized(Slices.Num());
+	int32 NumVertices = 0;
+	int32 NumFaces = 0;
+	int32 NumInfluences = 0;
+	for (int32 SliceIndex = 0; SliceIndex < Slices.Num(); ++SliceIndex)
+	{
+		const FCastMeshInfo& Mesh = *Slices[SliceIndex].Mesh;
+		Offsets[SliceIndex] = {NumVertices, NumFaces, NumInfluences};
+		NumVertices += Mesh.VertexPositions.Num();
+		NumFaces += Mesh.Faces.Num() / 3;
+		NumInfluences += Mesh.VertexWeightBone.Num();
+	}
+
+	Data.Points.SetNumUninitialized(NumVertices);
+	Data.Faces.SetNumZeroed(NumFaces);
+	Data.Wedges.SetNum(NumFaces * 3);
+	Data.Influences.SetNumUninitialized(NumInfluences);
+
+	ParallelFor(Slices.Num(), [&](int32 SliceIndex)
+	{
+		const FCastMeshSlice& Slice = Slices[SliceIndex];
+		const FSliceOffsets& Offset = Offsets[SliceIndex];
+		const FCastMeshInfo& Mesh = *Slice.Mesh;
+
+		// 顶点
+		for (int32 i = 0; i < Mesh.VertexPositions.Num(); ++i)
+		{
+			Data.Points[Offset.VertexOffset + i] = FVector3f(Mesh.VertexPositions[i].X,
+			                                                 -Mesh.VertexPositions[i].Y,
+			                                                 Mesh.VertexPositions[i].Z);
+		}
+
+		// 面 和 材质
+		const int32 MeshFaceCnt = Mesh.Faces.Num() / 3;
+		for (int32 FaceID = 0; FaceID < MeshFaceCnt; ++FaceID)
+		{
+			SkeletalMeshImportData::FTriangle& Triangle = Data.Faces[Offset.FaceOffset + FaceID];
+			Triangle.SmoothingGroups = 255;
+			uint32 TriangleVertexID[3] = {
+				Mesh.Faces[FaceID * 3], Mesh.Faces[FaceID * 3 + 1], Mesh.Faces[FaceID * 3 + 2]
+			};
+			for (int32 FaceVertexID = 0; FaceVertexID < 3; ++FaceVertexID)
+			{
+				const int32 WedgesID = (Offset.FaceOffset + FaceID) * 3 + FaceVertexID;
+				SkeletalMeshImportData::FVertex& Wedges = Data.Wedges[WedgesID];
+
+				const int32 MeshVertexID = TriangleVertexID[VertexOrder[FaceVertexID]];
+				Wedges.MatIndex = Slice.MatIdx;
+				Wedges.VertexIndex = MeshVertexID + Offset.VertexOffset;
+				if (Mesh.VertexColor.IsValidIndex(MeshVertexID))
+				{
+					Wedges.Color = FColor((Mesh.VertexColor[MeshVertexID] >> 0) & 0xFF,
+					                      (Mesh.VertexColor[MeshVertexID] >> 8) & 0xFF,
+					                      (Mesh.VertexColor[MeshVertexID] >> 16) & 0xFF,
+					                      (Mesh.VertexColor[MeshVertexID] >> 24) & 0xFF);
+				}
+				Wedges.UVs[0] = FVector2f(Mesh.VertexUV[MeshVertexID].X, Mesh.VertexUV[MeshVertexID].Y);
+				Wedges.Reserved = 0;
+
+				Triangle.TangentZ[FaceVertexID] = FVector3f{
+					Mesh.VertexNormals[MeshVertexID].X,
+					-Mesh.VertexNormals[MeshVertexID].Y,
+					Mesh.VertexNormals[MeshVertexID].Z
+				};
+				Triangle.TangentZ->Normalize();
+				Triangle.WedgeIndex[FaceVertexID] = WedgesID;
+			}
+			Triangle.MatIndex = Slice.MatIdx;
+		}
+
+		// 权重
+		for (uint32 WightID = 0; WightID < (uint32)Mesh.VertexWeightBone.Num(); ++WightID)
+		{
+			SkeletalMeshImportData::FRawBoneInfluence& Influence = Data.Influences[Offset.InfluenceOffset + WightID];
+			Influence.VertexIndex = (int32)(WightID / Mesh.MaxWeight) + Offset.VertexOffset;
+			Influence.BoneIndex = Mesh.VertexWeightBone[WightID] + Slice.BoneOffset;
+			Influence.Weight = Mesh.VertexWeightValue[WightID];
+		}
+	}, bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+}
+
 UStaticMesh* FCastImporter::ImportStaticMesh(UObject* InParent, const FName InName, EObjectFlags Flags)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::ImportStaticMesh);
@@ -1249,6 +1422,16 @@ UStaticMesh* FCastImporter::ImportStaticMesh(UObject* InParent, const FName InNa
 		}
 	}
 
+	if (bDeferStaticMeshBuilds)
+	{
+		DeferredStaticMeshes.AddUnique(StaticMesh);
+	}
+	else
+	{
+		BuildStaticMeshes({StaticMesh});
+	}
+	UpdateImportData(UCastStaticMeshImportData::GetImportDataForStaticMesh(StaticMesh, nullptr));
+
 	return StaticMesh;
 }
 
@@ -1260,6 +1443,9 @@ UAnimSequence* FCastImporter::ImportAnim(UObject* InParent, USkeleton* Skeleton)
 	}
 	UAnimSequence* AnimSequence = nullptr;
 
+	FAnimBoneTable BoneTable;
+	BoneTable.Build(Skeleton->GetReferenceSkeleton());
+
 	for (FCastRoot& Root : CastManager->Scene->Roots)
 	{
 		for (FCastAnimationInfo& Animation : Root.Animations)
@@ -1281,7 +1467,9 @@ UAnimSequence* FCastImporter::ImportAnim(UObject* InParent, USkeleton* Skeleton)
 			DestSeq->SetSkeleton(Skeleton);
 			DestSeq->ImportFileFramerate = Animation.Framerate;
 
-			ImportAnimation(Skeleton, DestSeq, Animation);
+			FResampledAnimation Resampled;
+			ResampleAnimation(BoneTable, Animation, Resampled);
+			ApplyResampledAnimation(Skeleton, DestSeq, Resampled);
 			AnimSequence = DestSeq;
 		}
 	}
@@ -1289,9 +1477,87 @@ UAnimSequence* FCastImporter::ImportAnim(UObject* InParent, USkeleton* Skeleton)
 	return AnimSequence;
 }
 
-void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelInfo& Model, UStaticMesh* StaticMesh)
+TArray<UAnimSequence*> FCastImporter::ImportAnimBatch(const TArray<FString>& Filenames, const FString& PackagePath,
+                                                      USkeleton* Skeleton, const FCastImportOptions& Options)
+{
+	TArray<UAnimSequence*> AnimSequences;
+	if (!Skeleton || Filenames.IsEmpty())
+	{
+		return AnimSequences;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::ImportAnimBatch);
+
+	// 重采样和写入轨道读取的是 ImportOptions，批量导入期间换成调用方给出的选项，
+	// 结果不受上一次导入遗留的选项影响
+	FCastImportOptions BatchOptions = Options;
+	FCastImportOptions* PreviousOptions = ImportOptions;
+	ImportOptions = &BatchOptions;
+	ON_SCOPE_EXIT
+	{
+		ImportOptions = PreviousOptions;
+	};
+
+	FAnimBoneTable BoneTable;
+	BoneTable.Build(Skeleton->GetReferenceSkeleton());
+
+	// 每个文件使用独立的 FCastManager，解析完成后立即释放文件映射，只保留重采样结果
+	TArray<TArray<FResampledAnimation>> FileAnimations;
+	FileAnimations.SetNum(Filenames.Num());
+	ParallelFor(Filenames.Num(), [&](int32 FileIndex)
+	{
+		FCastManager Manager;
+		if (!Manager.Initialize(Filenames[FileIndex]) || !Manager.Import())
+		{
+			UE_LOG(LogCast, Error, TEXT("Failed to load cast animation %s"), *Filenames[FileIndex]);
+			return;
+		}
+
+		TArray<FResampledAnimation>& Animations = FileAnimations[FileIndex];
+		for (const FCastRoot& Root : Manager.Scene->Roots)
+		{
+			const bool bMultipleAnimations = Root.Animations.Num() > 1;
+			for (const FCastAnimationInfo& Animation : Root.Animations)
+			{
+				FResampledAnimation& Resampled = Animations.AddDefaulted_GetRef();
+				ResampleAnimation(BoneTable, Animation, Resampled);
+				Resampled.Name = FPaths::GetBaseFilename(Filenames[FileIndex]);
+				if (bMultipleAnimations)
+				{
+					Resampled.Name += "_";
+					Resampled.Name += Animation.Name;
+				}
+			}
+		}
+		Manager.Destroy();
+	}, EParallelForFlags::Unbalanced);
+
+	// UObject 只能在游戏线程创建
+	for (const TArray<FResampledAnimation>& Animations : FileAnimations)
+	{
+		for (const FResampledAnimation& Resampled : Animations)
+		{
+			const FString SequenceName = NoIllegalSigns(Resampled.Name);
+			UObject* ParentPackage = CreatePackage(*FPaths::Combine(PackagePath, SequenceName));
+			UAnimSequence* DestSeq =
+				NewObject<UAnimSequence>(ParentPackage, *SequenceName, RF_Public | RF_Standalone);
+			CreatedObjects.Add(DestSeq);
+
+			DestSeq->SetSkeleton(Skeleton);
+			DestSeq->ImportFileFramerate = Resampled.Framerate;
+
+			ApplyResampledAnimation(Skeleton, DestSeq, Resampled);
+			AnimSequences.Add(DestSeq);
+		}
+	}
+
+	UE_LOG(LogCast, Log, TEXT("Imported %d animations from %d cast files"), AnimSequences.Num(), Filenames.Num());
+	return AnimSequences;
+}
+
+uint32 FCastImporter::FillStaticMeshDescription(FMeshDescription& MeshDescription, const FCastModelInfo& Model,
+                                                bool bParallel)
 {
-	FMeshDescription MeshDescription;
 	FStaticMeshAttributes Attributes(MeshDescription);
 	Attributes.Register();
 	Attributes.RegisterTriangleNormalAndTangentAttributes();
@@ -1304,69 +1570,81 @@ void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelI
 		Attributes.GetPolygonGroupMaterialSlotNames();
 
 	int32 VertexCount = 0;
+	int32 TriangleCount = 0;
 	uint32 UVLayer = 0;
+	TArray<int32> VertexIdOffset;
+	VertexIdOffset.Reserve(Model.Meshes.Num());
 
-	for (FCastMeshInfo& Mesh : Model.Meshes)
+	for (const FCastMeshInfo& Mesh : Model.Meshes)
 	{
+		VertexIdOffset.Add(VertexCount);
 		VertexCount += Mesh.VertexPositions.Num();
+		TriangleCount += Mesh.Faces.Num() / 3;
 		UVLayer = FMath::Max(UVLayer, Mesh.UVLayer);
 	}
 
 	VertexInstanceUVs.SetNumChannels(UVLayer + 1);
 	MeshDescription.ReserveNewVertices(VertexCount);
 	MeshDescription.ReserveNewVertexInstances(VertexCount);
-	MeshDescription.ReserveNewPolygons(VertexCount);
+	MeshDescription.ReserveNewTriangles(TriangleCount);
+	MeshDescription.ReserveNewPolygons(TriangleCount);
 	MeshDescription.ReserveNewEdges(VertexCount * 2);
-	TArray<FVertexInstanceID> VertexInstanceIDs;
-	VertexInstanceIDs.Reserve(VertexCount);
-	TArray<uint32> VertexIdOffset;
-	VertexIdOffset.Add(0);
 
-	for (FCastMeshInfo& Mesh : Model.Meshes)
+	// 新建的 MeshDescription 中 id 从 0 连续分配，顶点和顶点实例一一对应，
+	// 所以先整体创建，再直接写入属性数组
+	for (int32 i = 0; i < VertexCount; ++i)
 	{
-		for (int32 i = 0; i < (int32)Mesh.VertexPositions.Num(); ++i)
+		MeshDescription.CreateVertexInstance(MeshDescription.CreateVertex());
+	}
+
+	TArrayView<FVector3f> PositionArray = VertexPositions.GetRawArray();
+	TArrayView<FVector3f> NormalArray = VertexInstanceNormals.GetRawArray();
+	TArrayView<FVector4f> ColorArray = VertexInstanceColors.GetRawArray();
+	TArrayView<FVector2f> UVArray = VertexInstanceUVs.GetRawArray(0);
+
+	ParallelFor(Model.Meshes.Num(), [&](int32 MeshIndex)
+	{
+		const FCastMeshInfo& Mesh = Model.Meshes[MeshIndex];
+		const int32 Offset = VertexIdOffset[MeshIndex];
+		for (int32 i = 0; i < Mesh.VertexPositions.Num(); ++i)
 		{
-			const FVertexID VertexID = MeshDescription.CreateVertex();
-			VertexPositions[VertexID] = FVector3f(Mesh.VertexPositions[i].X,
+			PositionArray[Offset + i] = FVector3f(Mesh.VertexPositions[i].X,
 			                                      -Mesh.VertexPositions[i].Y,
 			                                      Mesh.VertexPositions[i].Z);
 
-			const FVertexInstanceID VertexInstanceID = MeshDescription.CreateVertexInstance(VertexID);
-			VertexInstanceIDs.Add(VertexInstanceID);
-
 			if (Mesh.VertexNormals.IsValidIndex(i))
 			{
-				VertexInstanceNormals[VertexInstanceID] = FVector3f(Mesh.VertexNormals[i].X,
-				                                                    -Mesh.VertexNormals[i].Y,
-				                                                    Mesh.VertexNormals[i].Z);
+				NormalArray[Offset + i] = FVector3f(Mesh.VertexNormals[i].X,
+				                                    -Mesh.VertexNormals[i].Y,
+				                                    Mesh.VertexNormals[i].Z);
 			}
 			if (Mesh.VertexColor.IsValidIndex(i))
 			{
-				VertexInstanceColors[VertexInstanceID] = FVector4f((Mesh.VertexColor[i] >> 0) & 0xFF,
-				                                                   (Mesh.VertexColor[i] >> 8) & 0xFF,
-				                                                   (Mesh.VertexColor[i] >> 16) & 0xFF,
-				                                                   (Mesh.VertexColor[i] >> 24) & 0xFF);
+				ColorArray[Offset + i] = FVector4f((Mesh.VertexColor[i] >> 0) & 0xFF,
+				                                   (Mesh.VertexColor[i] >> 8) & 0xFF,
+				                                   (Mesh.VertexColor[i] >> 16) & 0xFF,
+				                                   (Mesh.VertexColor[i] >> 24) & 0xFF);
 			}
 			if (Mesh.VertexUV.IsValidIndex(i))
-				VertexInstanceUVs.Set(VertexInstanceID, 0, FVector2f(Mesh.VertexUV[i].X, Mesh.VertexUV[i].Y));
+			{
+				UVArray[Offset + i] = FVector2f(Mesh.VertexUV[i].X, Mesh.VertexUV[i].Y);
+			}
 		}
-		VertexIdOffset.Add(MeshDescription.Vertices().Num());
-	}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-	for (uint32 k = 0; k < (uint32)Model.Meshes.Num(); ++k)
+	for (int32 k = 0; k < Model.Meshes.Num(); ++k)
 	{
 		const FCastMeshInfo& Mesh = Model.Meshes[k];
 		const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
 
-		for (int32 i = 0; i < (int32)Mesh.Faces.Num(); i += 3)
+		for (int32 i = 0; i + 2 < Mesh.Faces.Num(); i += 3)
 		{
-			TArray<FVertexInstanceID> TriangleVertexInstanceIDs;
-			for (int32 j = 0; j < 3; j++)
-			{
-				uint32 VertexIndex = Mesh.Faces[i + j] + VertexIdOffset[k];
-				TriangleVertexInstanceIDs.Add(VertexInstanceIDs[VertexIndex]);
-			}
-			MeshDescription.CreatePolygon(PolygonGroup, TriangleVertexInstanceIDs);
+			const FVertexInstanceID TriangleVertexInstanceIDs[3] = {
+				FVertexInstanceID(Mesh.Faces[i] + VertexIdOffset[k]),
+				FVertexInstanceID(Mesh.Faces[i + 1] + VertexIdOffset[k]),
+				FVertexInstanceID(Mesh.Faces[i + 2] + VertexIdOffset[k])
+			};
+			MeshDescription.CreateTriangle(PolygonGroup, MakeArrayView(TriangleVertexInstanceIDs));
 		}
 
 		uint32 MatIdx = *Model.MaterialMap.Find(Mesh.MaterialHash);
@@ -1375,6 +1653,14 @@ void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelI
 		PolygonGroupImportedMaterialSlotNames[PolygonGroup] = MatName;
 	}
 
+	return UVLayer;
+}
+
+void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelInfo& Model, UStaticMesh* StaticMesh)
+{
+	FMeshDescription MeshDescription;
+	const uint32 UVLayer = FillStaticMeshDescription(MeshDescription, Model);
+
 	StaticMesh->InitResources();
 	StaticMesh->SetLightingGuid();
 	FStaticMeshSourceModel& SrcModel = StaticMesh->AddSourceModel();
@@ -1383,7 +1669,7 @@ void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelI
 	SrcModel.BuildSettings.bRemoveDegenerates = false;
 	SrcModel.BuildSettings.bUseHighPrecisionTangentBasis = false;
 	SrcModel.BuildSettings.bUseFullPrecisionUVs = false;
-	SrcModel.BuildSettings.bGenerateLightmapUVs = true;
+	SrcModel.BuildSettings.bGenerateLightmapUVs = ImportOptions->bGenerateLightmapUVs;
 	SrcModel.BuildSettings.SrcLightmapIndex = 0;
 	SrcModel.BuildSettings.DstLightmapIndex = UVLayer;
 	SrcModel.BuildSettings.bUseMikkTSpace = true;
@@ -1419,11 +1705,51 @@ void FCastImporter::BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelI
 	StaticMesh->SetStaticMaterials(StaticMaterials);
 	StaticMesh->GetOriginalSectionInfoMap().CopyFrom(StaticMesh->GetSectionInfoMap());
 	StaticMesh->ImportVersion = LastVersion;
-	StaticMesh->Build(false);
-	StaticMesh->EnforceLightmapRestrictions();
-	StaticMesh->PostEditChange();
-	StaticMesh->GetPackage()->FullyLoad();
-	StaticMesh->MarkPackageDirty();
+}
+
+void FCastImporter::SetDeferStaticMeshBuilds(bool bDefer)
+{
+	bDeferStaticMeshBuilds = bDefer;
+	if (!bDefer)
+	{
+		FlushDeferredStaticMeshBuilds();
+	}
+}
+
+void FCastImporter::FlushDeferredStaticMeshBuilds()
+{
+	TArray<UStaticMesh*> StaticMeshes;
+	StaticMeshes.Reserve(DeferredStaticMeshes.Num());
+	for (const TWeakObjectPtr<UStaticMesh>& StaticMesh : DeferredStaticMeshes)
+	{
+		if (StaticMesh.IsValid())
+		{
+			StaticMeshes.Add(StaticMesh.Get());
+		}
+	}
+	DeferredStaticMeshes.Empty();
+
+	BuildStaticMeshes(StaticMeshes);
+}
+
+void FCastImporter::BuildStaticMeshes(const TArray<UStaticMesh*>& StaticMeshes)
+{
+	if (StaticMeshes.IsEmpty())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCastImporter::BuildStaticMeshes);
+
+	// BatchBuild 会把多个网格的构建分发到工作线程
+	UStaticMesh::BatchBuild(StaticMeshes);
+	for (UStaticMesh* StaticMesh : StaticMeshes)
+	{
+		StaticMesh->EnforceLightmapRestrictions();
+		StaticMesh->PostEditChange();
+		StaticMesh->GetPackage()->FullyLoad();
+		StaticMesh->MarkPackageDirty();
+	}
 }
 
 UObject* FCastImporter::CreateAssetOfClass(UClass* AssetClass, FString ParentPackageName, FString ObjectName,
@@ -1444,65 +1770,91 @@ UObject* FCastImporter::CreateAssetOfClass(UClass* AssetClass, FString ParentPac
 	return Object;
 }
 
-bool FCastImporter::ImportAnimation(USkeleton* Skeleton, UAnimSequence* DestSeq, FCastAnimationInfo& Animation)
+void FCastImporter::FAnimBoneTable::Build(const FReferenceSkeleton& RefSkeleton)
 {
-	IAnimationDataController& Controller = DestSeq->GetController();
-	InitializeAnimationController(Controller, Animation);
+	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+	RootName = RefSkeleton.GetNum() > 0 ? RefSkeleton.GetBoneName(0).ToString() : FString();
+	Bones.Empty(RefSkeleton.GetNum());
+	for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+	{
+		Bones.Add(RefSkeleton.GetBoneName(BoneIndex), {BoneIndex, RefBonePose[BoneIndex]});
+	}
+}
 
-	TMap<FString, BoneCurve> BoneMap = ExtractCurves(Skeleton, Animation);
+void FCastImporter::ResampleAnimation(const FAnimBoneTable& BoneTable, const FCastAnimationInfo& Animation,
+                                      FResampledAnimation& OutAnimation) const
+{
+	OutAnimation.Name = Animation.Name;
+	OutAnimation.Framerate = Animation.Framerate ? Animation.Framerate : 30;
+	OutAnimation.NumberOfFrames = CalculateNumberOfFrames(Animation);
 
-	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	TMap<FString, BoneCurve> BoneMap = ExtractCurves(BoneTable, Animation);
+	ResampleBoneTracks(BoneTable, BoneMap, OutAnimation.NumberOfFrames, OutAnimation.BoneTracks);
 
-	if (!ImportOptions->bConvertRefPosition)
+	if (ImportOptions->bImportAnimationNotify)
 	{
-		AddBoneCurves(Controller, RefSkeleton);
+		OutAnimation.NotificationTracks = Animation.NotificationTracks;
 	}
+}
 
-	uint32 NumberOfFrames = CalculateNumberOfFrames(Animation);
+void FCastImporter::ApplyResampledAnimation(USkeleton* Skeleton, UAnimSequence* DestSeq,
+                                            const FResampledAnimation& Animation)
+{
+	IAnimationDataController& Controller = DestSeq->GetController();
+	InitializeAnimationController(Controller, Animation.Framerate, Animation.NumberOfFrames);
 
-	PopulateBoneTracks(Controller, BoneMap, RefSkeleton, NumberOfFrames);
+	if (!ImportOptions->bConvertRefPosition)
+	{
+		AddBoneCurves(Controller, Skeleton->GetReferenceSkeleton());
+	}
 
-	if (!Animation.NotificationTracks.IsEmpty() && ImportOptions->bImportAnimationNotify)
+	// Controller 不是线程安全的，在这里串行提交
+	for (const FBoneTrackKeys& Track : Animation.BoneTracks)
 	{
-		AddAnimationNotifies(DestSeq, Animation, Animation.Framerate);
+		if (ImportOptions->bConvertRefPosition)
+		{
+			Controller.AddBoneCurve(Track.BoneName, false);
+		}
+		Controller.SetBoneTrackKeys(Track.BoneName, Track.PositionalKeys, Track.RotationalKeys, Track.ScalingKeys);
 	}
 
-	FinalizeController(Controller, DestSeq);
+	if (!Animation.NotificationTracks.IsEmpty())
+	{
+		AddAnimationNotifies(DestSeq, Animation.NotificationTracks, Animation.Framerate);
+	}
 
-	return true;
+	FinalizeController(Controller, DestSeq);
 }
 
-void FCastImporter::InitializeAnimationController(IAnimationDataController& Controller,
-                                                  const FCastAnimationInfo& Animation)
+void FCastImporter::InitializeAnimationController(IAnimationDataController& Controller, float Framerate,
+                                                  uint32 NumberOfFrames)
 {
 	Controller.InitializeModel();
 	Controller.OpenBracket(LOCTEXT("ImportAnimation_Bracket", "Importing Animation"), false);
 	Controller.RemoveAllBoneTracks(false);
-	float AnimationRate = Animation.Framerate ? Animation.Framerate : 30;
-	Controller.SetFrameRate(FFrameRate(AnimationRate, 1), false);
-	uint32 NumberOfFrames = CalculateNumberOfFrames(Animation);
+	Controller.SetFrameRate(FFrameRate(Framerate, 1), false);
 	Controller.SetNumberOfFrames(FFrameNumber((int32)NumberOfFrames), false);
 }
 
-uint32 FCastImporter::CalculateNumberOfFrames(const FCastAnimationInfo& Animation)
+uint32 FCastImporter::CalculateNumberOfFrames(const FCastAnimationInfo& Animation) const
 {
 	uint32 NumberOfFrames = 0;
 	for (const FCastCurveInfo& Curve : Animation.Curves)
 	{
+		if (Curve.KeyFrameBuffer.IsEmpty()) continue;
 		NumberOfFrames = FMath::Max(NumberOfFrames, Curve.KeyFrameBuffer.Last() + 1);
 	}
 	return NumberOfFrames;
 }
 
-TMap<FString, FCastImporter::BoneCurve> FCastImporter::ExtractCurves(USkeleton* Skeleton,
-                                                                     const FCastAnimationInfo& Animation)
+TMap<FString, FCastImporter::BoneCurve> FCastImporter::ExtractCurves(const FAnimBoneTable& BoneTable,
+                                                                     const FCastAnimationInfo& Animation) const
 {
 	TMap<FString, BoneCurve> BoneMap;
 
-	FName RootName = Skeleton->GetReferenceSkeleton().GetBoneName(0);
 	for (const FCastCurveInfo& Curve : Animation.Curves)
 	{
-		if (ImportOptions->bDeleteRootNodeAnim && Curve.NodeName == RootName)
+		if (ImportOptions->bDeleteRootNodeAnim && Curve.NodeName == BoneTable.RootName)
 		{
 			continue;
 		}
@@ -1516,35 +1868,35 @@ TMap<FString, FCastImporter::BoneCurve> FCastImporter::ExtractCurves(USkeleton*
 	return BoneMap;
 }
 
-void FCastImporter::AssignCurveValues(BoneCurve& BoneCurveInfo, const FCastCurveInfo& Curve)
+void FCastImporter::AssignCurveValues(BoneCurve& BoneCurveInfo, const FCastCurveInfo& Curve) const
 {
 	if (Curve.KeyPropertyName == "tx")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.PositionX, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.PositionX = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "ty")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.PositionY, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.PositionY = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "tz")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.PositionZ, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.PositionZ = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "rq")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.Rotation, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.Rotation = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "sx")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.ScaleX, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.ScaleX = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "sy")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.ScaleY, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.ScaleY = &Curve;
 	}
 	else if (Curve.KeyPropertyName == "sz")
 	{
-		InterpolateAnimationKeyframes(BoneCurveInfo.ScaleZ, Curve.KeyFrameBuffer, Curve.KeyValueBuffer);
+		BoneCurveInfo.ScaleZ = &Curve;
 	}
 }
 
@@ -1557,135 +1909,136 @@ void FCastImporter::AddBoneCurves(IAnimationDataController& Controller, const FR
 	}
 }
 
-void FCastImporter::PopulateBoneTracks(IAnimationDataController& Controller, const TMap<FString, BoneCurve>& BoneMap,
-                                       const FReferenceSkeleton& RefSkeleton, uint32 NumberOfFrames)
+void FCastImporter::ResampleBoneTracks(const FAnimBoneTable& BoneTable, const TMap<FString, BoneCurve>& BoneMap,
+                                       uint32 NumberOfFrames, TArray<FBoneTrackKeys>& OutBoneTracks) const
 {
+	TArray<const BoneCurve*> Curves;
+	Curves.Reserve(BoneMap.Num());
+	OutBoneTracks.Reset(BoneMap.Num());
 	for (const auto& BoneTransformKeys : BoneMap)
 	{
-		FName NewCurveName(BoneTransformKeys.Key);
-		TArray<FVector3f> PositionalKeys;
-		TArray<FQuat4f> RotationalKeys;
-		TArray<FVector3f> ScalingKeys;
+		OutBoneTracks.AddDefaulted_GetRef().BoneName = FName(BoneTransformKeys.Key);
+		Curves.Add(&BoneTransformKeys.Value);
+	}
 
-		int32 BoneID = RefSkeleton.FindBoneIndex(NewCurveName);
-		FVector BoneLocation = {0, 0, 0};
-		FQuat BoneRotation = {0, 0, 0, 1};
-		FVector BoneScale = {1, 1, 1};
+	// 各骨骼之间互不依赖，并行重采样
+	ParallelFor(OutBoneTracks.Num(), [&](int32 Index)
+	{
+		FBoneTrackKeys& Track = OutBoneTracks[Index];
 
-		if (RefSkeleton.GetRefBonePose().IsValidIndex(BoneID))
-		{
-			BoneLocation = RefSkeleton.GetRefBonePose()[BoneID].GetLocation();
-			BoneRotation = RefSkeleton.GetRefBonePose()[BoneID].GetRotation();
-			BoneScale = RefSkeleton.GetRefBonePose()[BoneID].GetScale3D();
-		}
+		const FAnimBoneTable::FBoneInfo* BoneInfo = BoneTable.Bones.Find(Track.BoneName);
+		const FTransform& RefPose = BoneInfo ? BoneInfo->RefPose : FTransform::Identity;
 
-		SetPositionalKeys(PositionalKeys, BoneTransformKeys.Value, BoneLocation, NumberOfFrames);
-		SetRotationalKeys(RotationalKeys, BoneTransformKeys.Value, BoneRotation, RefSkeleton, BoneID, NumberOfFrames);
-		SetScalingKeys(ScalingKeys, BoneTransformKeys.Value, BoneScale, NumberOfFrames);
+		SetPositionalKeys(Track.PositionalKeys, *Curves[Index], RefPose.GetLocation(), NumberOfFrames);
+		SetRotationalKeys(Track.RotationalKeys, *Curves[Index], RefPose.GetRotation(), BoneInfo != nullptr,
+		                  NumberOfFrames);
+		SetScalingKeys(Track.ScalingKeys, *Curves[Index], RefPose.GetScale3D(), NumberOfFrames);
+	});
+}
 
-		if (ImportOptions->bConvertRefPosition)
+namespace
+{
+	void ResampleCurve(const FCastCurveInfo* Curve, TArray<float>& OutValues)
+	{
+		if (Curve)
 		{
-			Controller.AddBoneCurve(NewCurveName, false);
+			AnimResampleHelper::ResampleFloatTrack(Curve->KeyFrameBuffer, Curve->FloatValueBuffer, OutValues);
 		}
-		Controller.SetBoneTrackKeys(NewCurveName, PositionalKeys, RotationalKeys, ScalingKeys);
 	}
 }
 
 void FCastImporter::SetPositionalKeys(TArray<FVector3f>& PositionalKeys, const BoneCurve& BoneCurveInfo,
-                                      const FVector& BoneLocation, uint32 NumberOfFrames)
+                                      const FVector& BoneLocation, uint32 NumberOfFrames) const
 {
-	for (int32 i = 0; i < BoneCurveInfo.PositionX.Num(); ++i)
+	if (!BoneCurveInfo.PositionX && !BoneCurveInfo.PositionY && !BoneCurveInfo.PositionZ)
 	{
-		if (ImportOptions->bConvertRefPosition)
-		{
-			PositionalKeys.Add({
-				BoneCurveInfo.PositionX[i] + (float)BoneLocation.X,
-				-(BoneCurveInfo.PositionY[i] + (float)BoneLocation.Y),
-				BoneCurveInfo.PositionZ[i] + (float)BoneLocation.Z
-			});
-		}
-		else
-		{
-			PositionalKeys.Add({
-				BoneCurveInfo.PositionX[i],
-				-BoneCurveInfo.PositionY[i],
-				BoneCurveInfo.PositionZ[i]
-			});
-		}
+		PositionalKeys.Init(ImportOptions->bConvertRefPosition ? FVector3f(BoneLocation) : FVector3f::ZeroVector,
+		                    FMath::Max<int32>(NumberOfFrames, 1));
+		return;
 	}
 
-	if (PositionalKeys.IsEmpty())
+	TArray<float> PositionX, PositionY, PositionZ;
+	PositionX.SetNumZeroed(NumberOfFrames);
+	PositionY.SetNumZeroed(NumberOfFrames);
+	PositionZ.SetNumZeroed(NumberOfFrames);
+	ResampleCurve(BoneCurveInfo.PositionX, PositionX);
+	ResampleCurve(BoneCurveInfo.PositionY, PositionY);
+	ResampleCurve(BoneCurveInfo.PositionZ, PositionZ);
+
+	const FVector3f Offset = ImportOptions->bConvertRefPosition ? FVector3f(BoneLocation) : FVector3f::ZeroVector;
+	PositionalKeys.SetNumUninitialized(NumberOfFrames);
+	for (uint32 i = 0; i < NumberOfFrames; ++i)
 	{
-		if (ImportOptions->bConvertRefPosition)
-		{
-			PositionalKeys.Add({(float)BoneLocation.X, (float)BoneLocation.Y, (float)BoneLocation.Z});
-		}
-		else
-		{
-			PositionalKeys.AddZeroed();
-		}
+		PositionalKeys[i] = {
+			PositionX[i] + Offset.X,
+			-(PositionY[i] + Offset.Y),
+			PositionZ[i] + Offset.Z
+		};
 	}
-
-	ExtendToFrameCount(PositionalKeys, NumberOfFrames);
 }
 
 void FCastImporter::SetRotationalKeys(TArray<FQuat4f>& RotationalKeys, const BoneCurve& BoneCurveInfo,
-                                      const FQuat& BoneRotation, const FReferenceSkeleton& RefSkeleton, int32 BoneID,
-                                      uint32 NumberOfFrames)
+                                      const FQuat& BoneRotation, bool bHasRefBone, uint32 NumberOfFrames) const
 {
-	for (int32 i = 0; i < BoneCurveInfo.Rotation.Num(); ++i)
+	if (!BoneCurveInfo.Rotation || BoneCurveInfo.Rotation->QuatValueBuffer.IsEmpty())
 	{
-		FQuat4f CurrentBoneRotation{
-			(float)BoneCurveInfo.Rotation[i].X,
-			-(float)BoneCurveInfo.Rotation[i].Y,
-			(float)BoneCurveInfo.Rotation[i].Z,
-			-(float)BoneCurveInfo.Rotation[i].W
-		};
+		RotationalKeys.Init({
+			                    (float)BoneRotation.X, (float)BoneRotation.Y, (float)BoneRotation.Z,
+			                    (float)BoneRotation.W
+		                    }, FMath::Max<int32>(NumberOfFrames, 1));
+		return;
+	}
 
-		if (ImportOptions->bConvertRefAnim && BoneID != INDEX_NONE)
-		{
-			FQuat4f RefRotation = FQuat4f(RefSkeleton.GetRefBonePose()[BoneID].GetRotation());
-			CurrentBoneRotation = RefRotation * CurrentBoneRotation;
-		}
+	TArray<FVector4f> Rotation;
+	Rotation.SetNumZeroed(NumberOfFrames);
+	AnimResampleHelper::ResampleQuatTrack(BoneCurveInfo.Rotation->KeyFrameBuffer,
+	                                      BoneCurveInfo.Rotation->QuatValueBuffer, Rotation);
 
-		RotationalKeys.Add(CurrentBoneRotation);
-		RotationalKeys.Last().Normalize();
-	}
+	const bool bApplyRefRotation = ImportOptions->bConvertRefAnim && bHasRefBone;
+	const FQuat4f RefRotation = bApplyRefRotation ? FQuat4f(BoneRotation) : FQuat4f::Identity;
 
-	if (RotationalKeys.IsEmpty())
+	RotationalKeys.SetNumUninitialized(NumberOfFrames);
+	for (uint32 i = 0; i < NumberOfFrames; ++i)
 	{
-		RotationalKeys.Add({
-			(float)BoneRotation.X, (float)BoneRotation.Y, (float)BoneRotation.Z, (float)BoneRotation.W
-		});
+		FQuat4f CurrentBoneRotation{Rotation[i].X, -Rotation[i].Y, Rotation[i].Z, -Rotation[i].W};
+		if (bApplyRefRotation)
+		{
+			CurrentBoneRotation = RefRotation * CurrentBoneRotation;
+		}
+		CurrentBoneRotation.Normalize();
+		RotationalKeys[i] = CurrentBoneRotation;
 	}
-
-	ExtendToFrameCount(RotationalKeys, NumberOfFrames);
 }
 
 void FCastImporter::SetScalingKeys(TArray<FVector3f>& ScalingKeys, const BoneCurve& BoneCurveInfo,
-                                   const FVector& BoneScale, uint32 NumberOfFrames)
+                                   const FVector& BoneScale, uint32 NumberOfFrames) const
 {
-	for (int32 i = 0; i < BoneCurveInfo.ScaleX.Num(); ++i)
+	if (!BoneCurveInfo.ScaleX && !BoneCurveInfo.ScaleY && !BoneCurveInfo.ScaleZ)
 	{
-		ScalingKeys.Add({
-			BoneCurveInfo.ScaleX[i],
-			BoneCurveInfo.ScaleY[i],
-			BoneCurveInfo.ScaleZ[i],
-		});
+		ScalingKeys.Init(FVector3f(BoneScale), FMath::Max<int32>(NumberOfFrames, 1));
+		return;
 	}
 
-	if (ScalingKeys.IsEmpty())
+	TArray<float> ScaleX, ScaleY, ScaleZ;
+	ScaleX.Init(1.f, NumberOfFrames);
+	ScaleY.Init(1.f, NumberOfFrames);
+	ScaleZ.Init(1.f, NumberOfFrames);
+	ResampleCurve(BoneCurveInfo.ScaleX, ScaleX);
+	ResampleCurve(BoneCurveInfo.ScaleY, ScaleY);
+	ResampleCurve(BoneCurveInfo.ScaleZ, ScaleZ);
+
+	ScalingKeys.SetNumUninitialized(NumberOfFrames);
+	for (uint32 i = 0; i < NumberOfFrames; ++i)
 	{
-		ScalingKeys.Add({(float)BoneScale.X, (float)BoneScale.Y, (float)BoneScale.Z});
+		ScalingKeys[i] = {ScaleX[i], ScaleY[i], ScaleZ[i]};
 	}
-
-	ExtendToFrameCount(ScalingKeys, NumberOfFrames);
 }
 
-void FCastImporter::AddAnimationNotifies(UAnimSequence* DestSeq, const FCastAnimationInfo& Animation,
+void FCastImporter::AddAnimationNotifies(UAnimSequence* DestSeq,
+                                         const TArray<FCastNotificationTrackInfo>& NotificationTracks,
                                          float AnimationRate)
 {
-	for (const FCastNotificationTrackInfo& NotificationTrack : Animation.NotificationTracks)
+	for (const FCastNotificationTrackInfo& NotificationTrack : NotificationTracks)
 	{
 		for (uint32 KeyFrame : NotificationTrack.KeyFrameBuffer)
 		{
@@ -0,0 +1,144 @@
+﻿#include "Utils/MeshWeldHelper.h"
+
+#include "CastManager/CastScene.h"
+#include "Hash/CityHash.h"
+
+namespace
+{
+	// 量化精度：位置约 0.001，法线和 UV 约 1/65536，权重约 1/1024
+	constexpr float PositionScale = 1024.f;
+	constexpr float DirectionScale = 65536.f;
+	constexpr float WeightScale = 1024.f;
+
+	using FWeldKey = TArray<int32, TInlineAllocator<32>>;
+
+	void BuildKey(const FCastMeshInfo& Mesh, int32 VertexIndex, FWeldKey& OutKey)
+	{
+		OutKey.Reset();
+
+		const FVector3f& Position = Mesh.VertexPositions[VertexIndex];
+		OutKey.Add(FMath::RoundToInt32(Position.X * PositionScale));
+		OutKey.Add(FMath::RoundToInt32(Position.Y * PositionScale));
+		OutKey.Add(FMath::RoundToInt32(Position.Z * PositionScale));
+
+		if (Mesh.VertexNormals.IsValidIndex(VertexIndex))
+		{
+			const FVector3f& Normal = Mesh.VertexNormals[VertexIndex];
+			OutKey.Add(FMath::RoundToInt32(Normal.X * DirectionScale));
+			OutKey.Add(FMath::RoundToInt32(Normal.Y * DirectionScale));
+			OutKey.Add(FMath::RoundToInt32(Normal.Z * DirectionScale));
+		}
+		if (Mesh.VertexUV.IsValidIndex(VertexIndex))
+		{
+			const FVector2f& UV = Mesh.VertexUV[VertexIndex];
+			OutKey.Add(FMath::RoundToInt32(UV.X * DirectionScale));
+			OutKey.Add(FMath::RoundToInt32(UV.Y * DirectionScale));
+		}
+		if (Mesh.VertexColor.IsValidIndex(VertexIndex))
+		{
+			OutKey.Add(static_cast<int32>(Mesh.VertexColor[VertexIndex]));
+		}
+
+		// 权重不同的顶点不能合并
+		const int32 FirstWeight = VertexIndex * Mesh.MaxWeight;
+		for (uint32 Slot = 0; Slot < Mesh.MaxWeight; ++Slot)
+		{
+			const int32 WeightIndex = FirstWeight + Slot;
+			if (!Mesh.VertexWeightBone.IsValidIndex(WeightIndex) || !Mesh.VertexWeightValue.IsValidIndex(WeightIndex))
+			{
+				break;
+			}
+			OutKey.Add(static_cast<int32>(Mesh.VertexWeightBone[WeightIndex]));
+			OutKey.Add(FMath::RoundToInt32(Mesh.VertexWeightValue[WeightIndex] * WeightScale));
+		}
+	}
+
+	template <typename T>
+	void CompactArray(TArray<T>& Array, TArrayView<const int32> KeptVertices, int32 Stride = 1)
+	{
+		if (Array.Num() < KeptVertices.Num() * Stride)
+		{
+			return;
+		}
+		// 保留的顶点按原顺序排列且 Kept[i] >= i，原地前移即可
+		for (int32 NewIndex = 0; NewIndex < KeptVertices.Num(); ++NewIndex)
+		{
+			for (int32 Slot = 0; Slot < Stride; ++Slot)
+			{
+				Array[NewIndex * Stride + Slot] = Array[KeptVertices[NewIndex] * Stride + Slot];
+			}
+		}
+		Array.SetNum(KeptVertices.Num() * Stride, EAllowShrinking::Yes);
+	}
+}
+
+int32 MeshWeldHelper::WeldVertices(FCastMeshInfo& Mesh)
+{
+	const int32 NumVertices = Mesh.VertexPositions.Num();
+	if (NumVertices == 0)
+	{
+		return 0;
+	}
+
+	// 哈希到第一个使用该哈希的顶点，冲突时用完整的量化值确认
+	TMultiMap<uint64, int32> HashToVertex;
+	HashToVertex.Reserve(NumVertices);
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(NumVertices);
+	TArray<int32> KeptVertices;
+	KeptVertices.Reserve(NumVertices);
+
+	FWeldKey Key;
+	FWeldKey OtherKey;
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+	{
+		BuildKey(Mesh, VertexIndex, Key);
+		const uint64 Hash = CityHash64(reinterpret_cast<const char*>(Key.GetData()), Key.Num() * sizeof(int32));
+
+		int32 Match = INDEX_NONE;
+		for (auto It = HashToVertex.CreateConstKeyIterator(Hash); It; ++It)
+		{
+			BuildKey(Mesh, KeptVertices[It.Value()], OtherKey);
+			if (OtherKey == Key)
+			{
+				Match = It.Value();
+				break;
+			}
+		}
+
+		if (Match == INDEX_NONE)
+		{
+			Match = KeptVertices.Add(VertexIndex);
+			HashToVertex.Add(Hash, Match);
+		}
+		Remap[VertexIndex] = Match;
+	}
+
+	const int32 NumRemoved = NumVertices - KeptVertices.Num();
+	if (NumRemoved == 0)
+	{
+		return 0;
+	}
+
+	for (uint32& VertexIndex : Mesh.Faces)
+	{
+		if (Remap.IsValidIndex(VertexIndex))
+		{
+			VertexIndex = Remap[VertexIndex];
+		}
+	}
+
+	CompactArray(Mesh.VertexPositions, KeptVertices);
+	CompactArray(Mesh.VertexNormals, KeptVertices);
+	CompactArray(Mesh.VertexTangents, KeptVertices);
+	CompactArray(Mesh.VertexColor, KeptVertices);
+	CompactArray(Mesh.VertexUV, KeptVertices);
+	CompactArray(Mesh.VertexWeights, KeptVertices);
+	if (Mesh.MaxWeight > 0)
+	{
+		CompactArray(Mesh.VertexWeightBone, KeptVertices, Mesh.MaxWeight);
+		CompactArray(Mesh.VertexWeightValue, KeptVertices, Mesh.MaxWeight);
+	}
+
+	return NumRemoved;
+}
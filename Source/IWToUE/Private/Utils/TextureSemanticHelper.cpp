@@ -0,0 +1,124 @@
+﻿#include "Utils/TextureSemanticHelper.h"
+
+#include "Engine/Texture2D.h"
+#include "Widgets/CastImportUI.h"
+
+namespace
+{
+	using namespace TextureSemanticHelper;
+
+	TMap<FName, FTextureSemantic> BuildSemanticTable()
+	{
+		TMap<FName, FTextureSemantic> Table;
+		auto AddGroup = [&Table](std::initializer_list<const TCHAR*> Types, FTextureSemantic Semantic)
+		{
+			for (const TCHAR* Type : Types)
+			{
+				Table.Add(FName(Type), Semantic);
+			}
+		};
+
+		AddGroup({
+			         TEXT("normalMap"), TEXT("normalBodyMap"),
+			         TEXT("detailMap"), TEXT("detailMap1"), TEXT("detailMap2"),
+			         TEXT("detailNormal1"), TEXT("detailNormal2"), TEXT("detailNormal3"), TEXT("detailNormal4"),
+			         TEXT("transitionNormal"), TEXT("flagRippleDetailMap"), TEXT("distortionMap"),
+			         TEXT("crackNormalMap")
+		         }, {TC_Normalmap, false});
+
+		AddGroup({
+			         TEXT("aoMap"), TEXT("alphaMaskMap"), TEXT("alphaMask"), TEXT("breakUpMap"),
+			         TEXT("specularMask"), TEXT("specularMaskDetail2"), TEXT("tintMask"), TEXT("tintBlendMask"),
+			         TEXT("thicknessMap"), TEXT("revealMap"), TEXT("transRevealMap"), TEXT("thermalHeatmap"),
+			         TEXT("transGlossMap"), TEXT("flickerLookupMap"),
+			         TEXT("glossMap"), TEXT("glossBodyMap"), TEXT("glossMapDetail2")
+		         }, {TC_Grayscale, true});
+
+		AddGroup({
+			         TEXT("customizeMask"), TEXT("flowMap"), TEXT("mixMap"), TEXT("camoMaskMap"),
+			         TEXT("detailNormalMask")
+		         }, {TC_Masks, false});
+
+		AddGroup({
+			         // IW8
+			         TEXT("unk_semantic_0x9"), TEXT("unk_semantic_0xA"),
+			         // IW9/JUP
+			         TEXT("unk_semantic_0x4"), TEXT("unk_semantic_0x5"),
+			         // T10
+			         TEXT("unk_semantic_0x58"), TEXT("unk_semantic_0x65")
+		         }, {TC_Default, true});
+
+		return Table;
+	}
+
+	TMap<FName, ETextureRole> BuildRoleTable(ECastMaterialType MaterialType)
+	{
+		TMap<FName, ETextureRole> Table;
+		switch (MaterialType)
+		{
+		case ECastMaterialType::CastMT_IW8:
+			Table.Add(TEXT("unk_semantic_0x0"), ETextureRole::Metallic);
+			Table.Add(TEXT("unk_semantic_0x4D"), ETextureRole::Skin);
+			Table.Add(TEXT("unk_semantic_0x85"), ETextureRole::Hair);
+			Table.Add(TEXT("unk_semantic_0x86"), ETextureRole::Eye);
+			break;
+		// IW9/T10 的皮肤、头发、眼睛语义尚未确认
+		case ECastMaterialType::CastMT_IW9:
+			Table.Add(TEXT("unk_semantic_0x0"), ETextureRole::Metallic);
+			break;
+		case ECastMaterialType::CastMT_T10:
+			Table.Add(TEXT("unk_semantic_0x57"), ETextureRole::Metallic);
+			break;
+		default: break;
+		}
+		return Table;
+	}
+
+	// FNAME_Find 不会把未知的类型加入名称表，查找只需对字符串做一次哈希
+	FName FindTypeName(const FString& TextureType)
+	{
+		return TextureType.IsEmpty() ? NAME_None : FName(*TextureType, FNAME_Find);
+	}
+}
+
+const TextureSemanticHelper::FTextureSemantic* TextureSemanticHelper::FindSemantic(const FString& TextureType)
+{
+	static const TMap<FName, FTextureSemantic> SemanticTable = BuildSemanticTable();
+
+	const FName TypeName = FindTypeName(TextureType);
+	return TypeName.IsNone() ? nullptr : SemanticTable.Find(TypeName);
+}
+
+void TextureSemanticHelper::ApplySemantic(UTexture2D* Texture, const FString& TextureType)
+{
+	const FTextureSemantic* Semantic = FindSemantic(TextureType);
+	if (!Semantic) return;
+
+	Texture->CompressionSettings = Semantic->Compression;
+	if (Semantic->bLinear)
+	{
+		Texture->SRGB = false;
+	}
+	if (Semantic->Compression == TC_Normalmap)
+	{
+		Texture->bFlipGreenChannel = false;
+	}
+}
+
+TextureSemanticHelper::ETextureRole TextureSemanticHelper::FindRole(ECastMaterialType MaterialType,
+                                                                    const FString& TextureType)
+{
+	static const TMap<FName, ETextureRole> RoleTables[] = {
+		BuildRoleTable(ECastMaterialType::CastMT_T7),
+		BuildRoleTable(ECastMaterialType::CastMT_IW8),
+		BuildRoleTable(ECastMaterialType::CastMT_IW9),
+		BuildRoleTable(ECastMaterialType::CastMT_T10),
+	};
+
+	const uint8 TableIndex = static_cast<uint8>(MaterialType);
+	const FName TypeName = FindTypeName(TextureType);
+	if (TypeName.IsNone() || TableIndex >= UE_ARRAY_COUNT(RoleTables)) return ETextureRole::None;
+
+	const ETextureRole* Role = RoleTables[TableIndex].Find(TypeName);
+	return Role ? *Role : ETextureRole::None;
+}
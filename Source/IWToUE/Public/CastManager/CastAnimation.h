@@ -26,11 +26,47 @@ struct FCastCurveInfo
 	FString NodeName;
 	// 可选类型 "rq", "tx", "ty", "tz", "sx", "sy", "sz", "bs", "vb"
 	FString KeyPropertyName;
+	// 帧和值按 SoA 存放，"rq" 的值在 QuatValueBuffer 中，其余在 FloatValueBuffer 中
 	TArray<uint32> KeyFrameBuffer;
-	TArray<FVariant> KeyValueBuffer;
+	TArray<float> FloatValueBuffer;
+	TArray<FVector4f> QuatValueBuffer;
 	FString Mode;
 	float AdditiveBlendWeight = 1.f;
 
+	bool IsQuaternion() const
+	{
+		return KeyPropertyName == TEXT("rq");
+	}
+
+	int32 GetNumValues() const
+	{
+		return IsQuaternion() ? QuatValueBuffer.Num() : FloatValueBuffer.Num();
+	}
+
+	void AddKey(uint32 Frame, float Value)
+	{
+		KeyFrameBuffer.Add(Frame);
+		FloatValueBuffer.Add(Value);
+	}
+
+	void AddKey(uint32 Frame, const FVector4f& Value)
+	{
+		KeyFrameBuffer.Add(Frame);
+		QuatValueBuffer.Add(Value);
+	}
+
+	/**
+	 * @brief 以 FVariant 形式取出一个键值，仅为兼容旧接口保留。
+	 */
+	FVariant GetKeyValue(int32 Index) const
+	{
+		if (IsQuaternion())
+		{
+			return QuatValueBuffer.IsValidIndex(Index) ? FVariant(FVector4(QuatValueBuffer[Index])) : FVariant();
+		}
+		return FloatValueBuffer.IsValidIndex(Index) ? FVariant(FloatValueBuffer[Index]) : FVariant();
+	}
+
 	/**
 	 * @brief 将帧缓冲和值缓冲转换为 TMap 格式。
 	 * @return TMap<uint32, FVariant> 帧号到键值的映射。如果缓冲大小不匹配则返回空 Map。
@@ -38,19 +74,19 @@ struct FCastCurveInfo
 	TMap<uint32, FVariant> GetKeysAsMap() const
 	{
 		TMap<uint32, FVariant> KeyMap;
-		if (KeyFrameBuffer.Num() == KeyValueBuffer.Num())
+		if (KeyFrameBuffer.Num() == GetNumValues())
 		{
 			for (int32 i = 0; i < KeyFrameBuffer.Num(); ++i)
 			{
-				KeyMap.Add(KeyFrameBuffer[i], KeyValueBuffer[i]);
+				KeyMap.Add(KeyFrameBuffer[i], GetKeyValue(i));
 			}
 		}
 		else
 		{
 			UE_LOG(LogTemp, Warning,
 			       TEXT(
-				       "FCastCurveInfo::GetKeysAsMap: KeyFrameBuffer (%d) and KeyValueBuffer (%d) size mismatch for Node '%s' Property '%s'."
-			       ), KeyFrameBuffer.Num(), KeyValueBuffer.Num(), *NodeName, *KeyPropertyName);
+				       "FCastCurveInfo::GetKeysAsMap: KeyFrameBuffer (%d) and value buffer (%d) size mismatch for Node '%s' Property '%s'."
+			       ), KeyFrameBuffer.Num(), GetNumValues(), *NodeName, *KeyPropertyName);
 		}
 		return KeyMap;
 	}
@@ -63,12 +99,12 @@ struct FCastCurveInfo
 	void SetKeysFromMap(const TMap<uint32, FVariant>& KeyMap)
 	{
 		KeyFrameBuffer.Empty(KeyMap.Num());
-		KeyValueBuffer.Empty(KeyMap.Num());
+		FloatValueBuffer.Empty();
+		QuatValueBuffer.Empty();
 
 		for (const auto& Pair : KeyMap)
 		{
-			KeyFrameBuffer.Add(Pair.Key);
-			KeyValueBuffer.Add(Pair.Value);
+			AddKey(Pair.Key, Pair.Value);
 		}
 	}
 
@@ -76,14 +112,62 @@ struct FCastCurveInfo
 	 * @brief 添加一个单独的关键帧。
 	 * 注意：不保证帧顺序，建议使用 SetKeysFromMap 或在添加完所有帧后手动排序。
 	 * @param Frame 帧号
-	 * @param Value 键值 (FVariant)
+	 * @param Value 键值 (FVariant)，会按曲线类型转换为 float 或四元数
 	 */
 	void AddKey(uint32 Frame, const FVariant& Value)
 	{
-		// 这里可以添加检查，确保 Value 类型与 KeyPropertyName 匹配，但这会增加复杂性
-		// 例如: if (KeyPropertyName == TEXT("rq") && !Value.IsType<FVector4>()) { /* 错误处理 */ }
-		KeyFrameBuffer.Add(Frame);
-		KeyValueBuffer.Add(Value);
+		if (IsQuaternion())
+		{
+			AddKey(Frame, FVector4f(Value.GetValue<FVector4>()));
+			return;
+		}
+		switch (Value.GetType())
+		{
+		case EVariantTypes::Float: AddKey(Frame, Value.GetValue<float>());
+			break;
+		case EVariantTypes::Double: AddKey(Frame, static_cast<float>(Value.GetValue<double>()));
+			break;
+		case EVariantTypes::Int32: AddKey(Frame, static_cast<float>(Value.GetValue<int32>()));
+			break;
+		case EVariantTypes::UInt32: AddKey(Frame, static_cast<float>(Value.GetValue<uint32>()));
+			break;
+		default:
+			UE_LOG(LogTemp, Warning, TEXT("FCastCurveInfo::AddKey: Unsupported value type for Property '%s'."),
+			       *KeyPropertyName);
+			break;
+		}
+	}
+
+	/**
+	 * @brief 按帧号排序，帧和值一起重排。
+	 */
+	void SortKeys()
+	{
+		const int32 NumKeys = KeyFrameBuffer.Num();
+		TArray<int32> Order;
+		Order.SetNumUninitialized(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i) Order[i] = i;
+		Order.StableSort([this](int32 A, int32 B) { return KeyFrameBuffer[A] < KeyFrameBuffer[B]; });
+
+		TArray<uint32> SortedFrames;
+		SortedFrames.SetNumUninitialized(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i) SortedFrames[i] = KeyFrameBuffer[Order[i]];
+		KeyFrameBuffer = MoveTemp(SortedFrames);
+
+		if (IsQuaternion())
+		{
+			TArray<FVector4f> SortedValues;
+			SortedValues.SetNumUninitialized(NumKeys);
+			for (int32 i = 0; i < NumKeys; ++i) SortedValues[i] = QuatValueBuffer[Order[i]];
+			QuatValueBuffer = MoveTemp(SortedValues);
+		}
+		else
+		{
+			TArray<float> SortedValues;
+			SortedValues.SetNumUninitialized(NumKeys);
+			for (int32 i = 0; i < NumKeys; ++i) SortedValues[i] = FloatValueBuffer[Order[i]];
+			FloatValueBuffer = MoveTemp(SortedValues);
+		}
 	}
 };
 
@@ -219,7 +303,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("rq")))
 		{
-			Curve->AddKey(Frame, FVariant(Rotation));
+			Curve->AddKey(Frame, FVector4f(Rotation));
 		}
 	}
 
@@ -234,15 +318,15 @@ public:
 	{
 		if (FCastCurveInfo* CurveX = FindOrAddCurve(NodeName, TEXT("tx")))
 		{
-			CurveX->AddKey(Frame, FVariant(static_cast<float>(Translation.X)));
+			CurveX->AddKey(Frame, static_cast<float>(Translation.X));
 		}
 		if (FCastCurveInfo* CurveY = FindOrAddCurve(NodeName, TEXT("ty")))
 		{
-			CurveY->AddKey(Frame, FVariant(static_cast<float>(Translation.Y)));
+			CurveY->AddKey(Frame, static_cast<float>(Translation.Y));
 		}
 		if (FCastCurveInfo* CurveZ = FindOrAddCurve(NodeName, TEXT("tz")))
 		{
-			CurveZ->AddKey(Frame, FVariant(static_cast<float>(Translation.Z)));
+			CurveZ->AddKey(Frame, static_cast<float>(Translation.Z));
 		}
 	}
 
@@ -256,7 +340,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("tx")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -270,7 +354,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("ty")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -284,7 +368,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("tz")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -299,15 +383,15 @@ public:
 	{
 		if (FCastCurveInfo* CurveX = FindOrAddCurve(NodeName, TEXT("sx")))
 		{
-			CurveX->AddKey(Frame, FVariant(static_cast<float>(Scale.X)));
+			CurveX->AddKey(Frame, static_cast<float>(Scale.X));
 		}
 		if (FCastCurveInfo* CurveY = FindOrAddCurve(NodeName, TEXT("sy")))
 		{
-			CurveY->AddKey(Frame, FVariant(static_cast<float>(Scale.Y)));
+			CurveY->AddKey(Frame, static_cast<float>(Scale.Y));
 		}
 		if (FCastCurveInfo* CurveZ = FindOrAddCurve(NodeName, TEXT("sz")))
 		{
-			CurveZ->AddKey(Frame, FVariant(static_cast<float>(Scale.Z)));
+			CurveZ->AddKey(Frame, static_cast<float>(Scale.Z));
 		}
 	}
 
@@ -321,7 +405,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("sx")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -335,7 +419,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("sy")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -349,7 +433,7 @@ public:
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("sz")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -365,7 +449,7 @@ public:
 		// KeyPropertyName 固定为 "bs"
 		if (FCastCurveInfo* Curve = FindOrAddCurve(BlendShapeNodeName, TEXT("bs")))
 		{
-			Curve->AddKey(Frame, FVariant(Value));
+			Curve->AddKey(Frame, Value);
 		}
 	}
 
@@ -374,13 +458,13 @@ public:
 	 * @param NodeName 节点名称。
 	 * @param Frame 帧号。
 	 * @param bIsVisible true 表示可见 (对应 "i")，false 表示隐藏 (对应 "h")。
-	 *                  注意：KeyValueBuffer 存储的是 FString("i") 或 FString("h")。
+	 *                  注意：FloatValueBuffer 中存储 1 或 0。
 	 */
 	void AddVisibilityKey(const FString& NodeName, uint32 Frame, bool bIsVisible)
 	{
 		if (FCastCurveInfo* Curve = FindOrAddCurve(NodeName, TEXT("vb")))
 		{
-			Curve->AddKey(Frame, FVariant(bIsVisible ? 1 : 0));
+			Curve->AddKey(Frame, bIsVisible ? 1.f : 0.f);
 		}
 	}
 
@@ -414,36 +498,14 @@ public:
 	{
 		for (FCastCurveInfo& Curve : Curves)
 		{
-			if (Curve.KeyFrameBuffer.Num() != Curve.KeyValueBuffer.Num())
+			if (Curve.KeyFrameBuffer.Num() != Curve.GetNumValues())
 			{
 				UE_LOG(LogTemp, Warning,
 				       TEXT("SortAllKeyframes: Skipping curve '%s' for node '%s' due to buffer size mismatch."),
 				       *Curve.KeyPropertyName, *Curve.NodeName);
 				continue;
 			}
-
-			// 创建 Pair 数组用于排序
-			TArray<TPair<uint32, FVariant>> KeyPairs;
-			KeyPairs.Reserve(Curve.KeyFrameBuffer.Num());
-			for (int32 i = 0; i < Curve.KeyFrameBuffer.Num(); ++i)
-			{
-				KeyPairs.Emplace(Curve.KeyFrameBuffer[i], Curve.KeyValueBuffer[i]);
-			}
-
-			// 按帧号排序
-			KeyPairs.Sort([](const TPair<uint32, FVariant>& A, const TPair<uint32, FVariant>& B)
-			{
-				return A.Key < B.Key;
-			});
-
-			// 将排序后的结果写回 Buffer
-			Curve.KeyFrameBuffer.Reset(KeyPairs.Num());
-			Curve.KeyValueBuffer.Reset(KeyPairs.Num());
-			for (const auto& Pair : KeyPairs)
-			{
-				Curve.KeyFrameBuffer.Add(Pair.Key);
-				Curve.KeyValueBuffer.Add(Pair.Value);
-			}
+			Curve.SortKeys();
 		}
 
 		for (FCastNotificationTrackInfo& Track : NotificationTracks)
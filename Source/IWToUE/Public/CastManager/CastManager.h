@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "CastScene.h"
+#include "Async/MappedFileHandle.h"
 #include "Serialization/LargeMemoryReader.h"
 
 struct FCastAnimationInfo;
@@ -8,16 +9,22 @@ struct FCastMaterialInfo;
 struct FCastSkeletonInfo;
 struct FCastModelInfo;
 
-#define COPY_ARR(src_arr, dst_arr) for (const auto& Val : src_arr) dst_arr.Add(Val);
-
 class FCastManager
 {
 public:
 	~FCastManager();
 
 	bool Initialize(FString InFilePath);
+	// 直接使用已在内存中的文件数据，InFilePath 只用于日志
+	bool Initialize(TArray64<uint8>&& InFileData, FString InFilePath);
 	bool Import();
 
+	/**
+	 * @brief 只遍历节点头并跳过属性数据，快速统计网格/动画信息，用于判断导入类型。
+	 * 不映射文件也不解码任何数组。
+	 */
+	static bool ScanFile(const FString& InFilePath, FCastSceneInfo& OutInfo);
+
 	void Destroy();
 
 	TUniquePtr<FCastScene> Scene{nullptr};
@@ -27,17 +34,32 @@ public:
 	int32 GetFaceNum() const;
 
 protected:
-	int32 GetNode();
+	// Root 下的一棵独立子树(Model/Animation/Instance...)在文件中的位置
+	struct FCastSubtree
+	{
+		int32 RootIndex;
+		uint32 Identifier;
+		int64 Offset;
+	};
 
-	void ProcessCastData(FCastNode& Node);
-	void ProcessRootData(FCastNode& Node, FCastRoot& Root);
-	void ProcessModelData(FCastNode& Node, FCastModelInfo& Model);
-	void ProcessSkeletonData(FCastNode& Node, FCastSkeletonInfo& Skeleton);
-	void ProcessMaterialData(FCastNode& Node, FCastMaterialInfo& Material);
-	void ProcessAnimationData(FCastNode& Node, FCastAnimationInfo& Animation);
+	bool IndexSubtrees(TArray<FCastSubtree>& OutSubtrees);
+	bool ReadProperty(FArchive& Ar, FCastNodeProperty& Property) const;
+	int32 ReadNode(FArchive& Ar, FCastNodeTree& Tree) const;
+
+	void ProcessRootData(const FCastNodeTree& Tree, const FCastNode& Node, FCastRoot& Root) const;
+	void ProcessModelData(const FCastNodeTree& Tree, const FCastNode& Node, FCastModelInfo& Model) const;
+	void ProcessSkeletonData(const FCastNodeTree& Tree, const FCastNode& Node, FCastSkeletonInfo& Skeleton) const;
+	void ProcessMaterialData(const FCastNodeTree& Tree, const FCastNode& Node, FCastMaterialInfo& Material) const;
 
 private:
+	void ReleaseFile();
+
+	// 优先使用文件映射，失败时回退到整体读取
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
 	TArray64<uint8> FileDataOld;
+	const uint8* FileData{nullptr};
+	int64 FileSize{0};
 	TUniquePtr<FLargeMemoryReader> Reader;
 
 	FString FilePath;
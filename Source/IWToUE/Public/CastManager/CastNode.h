@@ -42,26 +42,71 @@ enum class ECastPropertyId : uint16_t
 	Vector4 = 'v4' // Float precision vector XYZW
 };
 
+template <typename T>
+struct TCastPropertyType;
+
+template <> struct TCastPropertyType<uint8> { static constexpr ECastPropertyId Id = ECastPropertyId::Byte; };
+template <> struct TCastPropertyType<uint16> { static constexpr ECastPropertyId Id = ECastPropertyId::Short; };
+template <> struct TCastPropertyType<uint32> { static constexpr ECastPropertyId Id = ECastPropertyId::Integer32; };
+template <> struct TCastPropertyType<uint64> { static constexpr ECastPropertyId Id = ECastPropertyId::Integer64; };
+template <> struct TCastPropertyType<float> { static constexpr ECastPropertyId Id = ECastPropertyId::Float; };
+template <> struct TCastPropertyType<double> { static constexpr ECastPropertyId Id = ECastPropertyId::Double; };
+template <> struct TCastPropertyType<FVector2f> { static constexpr ECastPropertyId Id = ECastPropertyId::Vector2; };
+template <> struct TCastPropertyType<FVector3f> { static constexpr ECastPropertyId Id = ECastPropertyId::Vector3; };
+template <> struct TCastPropertyType<FVector4f> { static constexpr ECastPropertyId Id = ECastPropertyId::Vector4; };
+
+/**
+ * @brief 属性名转换为整数 id，便于 switch 分发。
+ * 不超过 4 字节的名称按小端直接打包("vp" -> 'v' | 'p' << 8)，更长的名称使用 FNV-1a 并置最高位，两者不会重叠。
+ */
+constexpr uint32 CastPropertyNameId(const ANSICHAR* Name, uint32 Length)
+{
+	if (Length <= 4)
+	{
+		uint32 Id = 0;
+		for (uint32 i = 0; i < Length; ++i)
+		{
+			Id |= static_cast<uint32>(static_cast<uint8>(Name[i])) << (i * 8);
+		}
+		return Id;
+	}
+	uint32 Hash = 2166136261u;
+	for (uint32 i = 0; i < Length; ++i)
+	{
+		Hash ^= static_cast<uint8>(Name[i]);
+		Hash *= 16777619u;
+	}
+	return Hash | 0x80000000u;
+}
+
+constexpr uint32 CastPropertyNameId(const ANSICHAR* Name)
+{
+	uint32 Length = 0;
+	while (Name[Length] != 0) ++Length;
+	return CastPropertyNameId(Name, Length);
+}
+
+// 打包的短名称首字母，用于 "c0"/"u1" 这类带层号的属性
+constexpr ANSICHAR CastPropertyNamePrefix(uint32 NameId)
+{
+	return (NameId & 0x80000000u) ? 0 : static_cast<ANSICHAR>(NameId & 0xFF);
+}
+
+// 紧凑的属性描述(24 字节，含 DataOffset 前的 4 字节填充)，数据本身留在场景的数据区(文件映射)中，
+// 通过 FCastScene::GetSpan 访问
 struct FCastNodeProperty
 {
-	uint16 Identifier; // The element type of this property
-	ECastPropertyId DataType;
+	ECastPropertyId DataType; // The element type of this property
 	uint16 NameSize; // The size of the name of this property
-	uint32 ArrayLength; // The number of elements this property contains (1 for single)
-
-	FString PropertyName;
-
-	TArray<uint8> ByteArray;
-	TArray<uint16> ShortArray;
-	TArray<uint32> IntArray;
-	TArray<uint64> Int64Array;
-	TArray<float> FloatArray;
-	TArray<double> DoubleArray;
-	FString StringData;
-	TArray<FVector2f> Vector2Array;
-	TArray<FVector3f> Vector3Array;
-	TArray<FVector4f> Vector4Array;
+	uint32 ArrayLength; // The number of elements this property contains (1 for single), byte length for strings
+	uint32 NameId; // CastPropertyNameId of the name, computed once while parsing
+	uint64 DataOffset; // Offset of the payload in the scene arena, the name is stored right before it
+
+	static uint32 GetElementSize(ECastPropertyId Type);
+
+	uint64 GetNameOffset() const { return DataOffset - NameSize; }
 };
+static_assert(sizeof(FCastNodeProperty) == 24, "FCastNodeProperty is expected to stay a 24-byte record");
 
 class FCastNode
 {
@@ -74,9 +119,20 @@ public:
 	void SetName(FString& InName);
 
 	FCastNodeHeader Header;
-	TArray<FCastNodeProperty> Properties;
+	// 属性存放在所属 FCastNodeTree::Properties 中，[FirstProperty, FirstProperty + Header.PropertyCount)
+	int32 FirstProperty{0};
 	TArray<int32> ChildNodes;
 
 private:
 	FString NodeName;
 };
+
+// 一棵子树解析出的节点和属性，子树之间互不引用，可以并行解码
+struct FCastNodeTree
+{
+	TArray<FCastNode> Nodes;
+	// 所有节点的属性连续存放
+	TArray<FCastNodeProperty> Properties;
+
+	TArrayView<const FCastNodeProperty> GetProperties(const FCastNode& Node) const;
+};
@@ -1,7 +1,107 @@
 ﻿#pragma once
 
+#include "CastNode.h"
+
 struct FCastRoot;
-class FCastNode;
+
+namespace CastWiden
+{
+	// 按 8 个元素一组转换，便于编译器自动向量化；数据区不保证对齐，先整块拷贝再转换
+	template <typename DstType, typename SrcType>
+	void Convert(const SrcType* Src, int32 Num, DstType* Dst)
+	{
+		constexpr int32 BlockSize = 8;
+		int32 Index = 0;
+		for (; Index + BlockSize <= Num; Index += BlockSize)
+		{
+			SrcType Block[BlockSize];
+			FMemory::Memcpy(Block, Src + Index, sizeof(Block));
+			for (int32 Lane = 0; Lane < BlockSize; ++Lane)
+			{
+				Dst[Index + Lane] = static_cast<DstType>(Block[Lane]);
+			}
+		}
+		for (; Index < Num; ++Index)
+		{
+			SrcType Value;
+			FMemory::Memcpy(&Value, Src + Index, sizeof(SrcType));
+			Dst[Index] = static_cast<DstType>(Value);
+		}
+	}
+}
+
+/**
+ * @brief 属性数据的类型化视图，数据区不保证按 T 对齐，元素通过 Memcpy 按值读取。
+ * 对齐时可以用 GetAlignedView 取得零拷贝的 TArrayView。
+ */
+template <typename T>
+class TCastSpan
+{
+public:
+	TCastSpan() = default;
+
+	TCastSpan(const uint8* InData, int32 InNum)
+		: Data(InData), NumElements(InNum)
+	{
+	}
+
+	int32 Num() const { return NumElements; }
+	bool IsEmpty() const { return NumElements == 0; }
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < NumElements; }
+
+	T operator[](int32 Index) const
+	{
+		check(IsValidIndex(Index));
+		T Value;
+		FMemory::Memcpy(&Value, Data + static_cast<SIZE_T>(Index) * sizeof(T), sizeof(T));
+		return Value;
+	}
+
+	bool IsDataAligned() const { return IsAligned(Data, alignof(T)); }
+
+	// 数据未对齐时返回空视图
+	TArrayView<const T> GetAlignedView() const
+	{
+		return IsDataAligned() ? TArrayView<const T>(reinterpret_cast<const T*>(Data), NumElements)
+			       : TArrayView<const T>();
+	}
+
+	// 整块拷贝到 OutArray，复用其已有分配
+	void CopyTo(TArray<T>& OutArray) const
+	{
+		OutArray.SetNumUninitialized(NumElements, EAllowShrinking::No);
+		FMemory::Memcpy(OutArray.GetData(), Data, static_cast<SIZE_T>(NumElements) * sizeof(T));
+	}
+
+	TArray<T> ToArray() const
+	{
+		TArray<T> Result;
+		CopyTo(Result);
+		return Result;
+	}
+
+	const uint8* GetRawData() const { return Data; }
+
+	class FIterator
+	{
+	public:
+		FIterator(const TCastSpan& InSpan, int32 InIndex) : Span(InSpan), Index(InIndex) {}
+		T operator*() const { return Span[Index]; }
+		FIterator& operator++() { ++Index; return *this; }
+		bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+
+	private:
+		const TCastSpan& Span;
+		int32 Index;
+	};
+
+	FIterator begin() const { return FIterator(*this, 0); }
+	FIterator end() const { return FIterator(*this, NumElements); }
+
+private:
+	const uint8* Data{nullptr};
+	int32 NumElements{0};
+};
 
 struct FCastWeightsData
 {
@@ -133,14 +233,110 @@ public:
 	bool HasAnimation() const;
 	float GetAnimFramerate() const;
 
-	FCastNode* GetNode(int32 Idx);
+	// 数据区为文件映射(或整体读取的缓冲)，由 FCastManager 持有，场景释放前必须保持有效
+	void SetArena(const uint8* InData, int64 InSize);
+	const uint8* GetArenaData() const { return ArenaData; }
+	int64 GetArenaSize() const { return ArenaSize; }
+
+	FAnsiStringView GetPropertyName(const FCastNodeProperty& Property) const;
+	FString GetString(const FCastNodeProperty& Property) const;
+
+	/**
+	 * @brief 以指定类型查看属性数据，类型不匹配时返回空视图。
+	 * 属性在文件中紧跟名称，通常不对齐，TCastSpan 按值读取元素，不要求对齐。
+	 */
+	template <typename T>
+	TCastSpan<T> GetSpan(const FCastNodeProperty& Property) const
+	{
+		// cast 文件为小端，视图直接解释数据区
+		static_assert(PLATFORM_LITTLE_ENDIAN, "Cast data is little-endian");
+
+		if (Property.DataType != TCastPropertyType<T>::Id || !ArenaData)
+		{
+			return TCastSpan<T>();
+		}
+		return TCastSpan<T>(ArenaData + Property.DataOffset, Property.ArrayLength);
+	}
+
+	/**
+	 * @brief 对齐时返回零拷贝视图，否则拷贝到 Scratch 并返回 Scratch 的视图。
+	 * 类型不匹配时返回空视图。
+	 */
+	template <typename T>
+	TArrayView<const T> ViewArray(const FCastNodeProperty& Property, TArray<T>& Scratch) const
+	{
+		const TCastSpan<T> Span = GetSpan<T>(Property);
+		if (Span.IsDataAligned())
+		{
+			return Span.GetAlignedView();
+		}
+		Span.CopyTo(Scratch);
+		return Scratch;
+	}
+
+	/**
+	 * @brief 把 b/h/i 类型的整数数组属性转换为 DstType。
+	 * 宽度相同时直接整体拷贝到 OutArray(复用其已有分配)，不逐元素转换。
+	 * @return 属性不是整数数组时清空 OutArray 并返回 false
+	 */
+	template <typename DstType>
+	bool WidenArray(const FCastNodeProperty& Property, TArray<DstType>& OutArray) const
+	{
+		switch (Property.DataType)
+		{
+		case ECastPropertyId::Byte:
+			return WidenArrayFrom<uint8>(Property, OutArray);
+		case ECastPropertyId::Short:
+			return WidenArrayFrom<uint16>(Property, OutArray);
+		case ECastPropertyId::Integer32:
+			return WidenArrayFrom<uint32>(Property, OutArray);
+		default:
+			OutArray.Reset();
+			return false;
+		}
+	}
+
+	template <typename T>
+	T GetValue(const FCastNodeProperty& Property, uint32 Index = 0) const
+	{
+		T Value{};
+		if (Property.DataType == TCastPropertyType<T>::Id && ArenaData && Index < Property.ArrayLength)
+		{
+			FMemory::Memcpy(&Value, ArenaData + Property.DataOffset + Index * sizeof(T), sizeof(T));
+		}
+		return Value;
+	}
 
 	FCastHeader Header{};
 
-	TArray<int32> RootNodes;
-	TArray<FCastNode> Nodes;
+	// 节点只在解码期间存在，这里仅保留数量
+	int32 NodeCount{0};
 
 	TArray<FCastRoot> Roots;
 
 private:
+	template <typename SrcType, typename DstType>
+	bool WidenArrayFrom(const FCastNodeProperty& Property, TArray<DstType>& OutArray) const
+	{
+		if (!ArenaData)
+		{
+			OutArray.Reset();
+			return false;
+		}
+		const TCastSpan<SrcType> Span = GetSpan<SrcType>(Property);
+		if constexpr (std::is_same_v<SrcType, DstType>)
+		{
+			Span.CopyTo(OutArray);
+		}
+		else
+		{
+			OutArray.SetNumUninitialized(Span.Num(), EAllowShrinking::No);
+			CastWiden::Convert(reinterpret_cast<const SrcType*>(Span.GetRawData()), OutArray.Num(),
+			                   OutArray.GetData());
+		}
+		return true;
+	}
+
+	const uint8* ArenaData{nullptr};
+	int64 ArenaSize{0};
 };
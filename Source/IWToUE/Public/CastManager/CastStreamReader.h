@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include "CastAnimation.h"
+#include "CastNode.h"
+#include "CastScene.h"
+#include "Serialization/LargeMemoryReader.h"
+
+/**
+ * @brief 流式读取时一条曲线的视图。
+ * 帧和值指向文件映射或读取器内部的缓冲，只在回调期间有效。
+ */
+struct FCastCurveView
+{
+	FString NodeName;
+	FString KeyPropertyName;
+	FString Mode;
+	float AdditiveBlendWeight{1.f};
+
+	TArrayView<const uint32> KeyFrames;
+	// 整数值会被转换为 float，"rq" 使用 QuatValues
+	TArrayView<const float> FloatValues;
+	TArrayView<const FVector4f> QuatValues;
+};
+
+class ICastAnimationVisitor
+{
+public:
+	virtual ~ICastAnimationVisitor() = default;
+
+	virtual void BeginAnimation(const FString& Name, float Framerate, bool bLooping) = 0;
+	virtual void OnCurve(const FCastCurveView& Curve) = 0;
+	virtual void OnCurveModeOverride(const FCastCurveModeOverrideInfo& CurveModeOverride) = 0;
+	virtual void OnNotificationTrack(const FString& Name, TArrayView<const uint32> KeyFrames) = 0;
+	virtual void EndAnimation() = 0;
+};
+
+/**
+ * @brief SAX 风格的 Animation 读取器，直接在文件映射上遍历节点，不构建节点树。
+ * 每遇到一个 Curve/NotificationTrack 节点就回调一次，类型转换使用可复用的临时缓冲。
+ */
+class FCastStreamReader
+{
+public:
+	explicit FCastStreamReader(const FCastScene& InScene);
+
+	/**
+	 * @brief 从 Offset 处的 Animation 节点开始读取。
+	 * @return 数据越界或节点类型不符时返回 false
+	 */
+	bool ReadAnimation(int64 Offset, ICastAnimationVisitor& Visitor);
+
+	/**
+	 * @brief 读取一个属性头并跳过数据，数据只记录位置不拷贝。
+	 */
+	static bool ReadProperty(FArchive& Ar, const uint8* Data, int64 Size, FCastNodeProperty& Property);
+
+private:
+	bool ReadNodeHeader(FCastNodeHeader& Header);
+	bool ReadCurve(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor);
+	bool ReadCurveModeOverride(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor);
+	bool ReadNotificationTrack(const FCastNodeHeader& Header, ICastAnimationVisitor& Visitor);
+
+	TArrayView<const uint32> GetKeyFrames(const FCastNodeProperty& Property);
+	TArrayView<const float> GetFloatValues(const FCastNodeProperty& Property);
+
+	const FCastScene& Scene;
+	FLargeMemoryReader Reader;
+
+	TArray<uint32> FrameScratch;
+	TArray<float> FloatScratch;
+	// 数据没有对齐时的拷贝
+	TArray<FVector4f> QuatScratch;
+};
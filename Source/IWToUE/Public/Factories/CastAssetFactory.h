@@ -45,7 +45,9 @@ public:
 	//~ Begin UFactor Interface
 	virtual bool DoesSupportClass(UClass* Class) override;
 	virtual UClass* ResolveSupportedClass() override;
-	UObject* HandleExistingAsset(UObject* InParent, FName InName, const FString& InFilename);
+	virtual void CleanUp() override;
+	UObject* HandleExistingAsset(UObject* InParent, FName InName, const FString& InFilename,
+	                             FCastImporter* CastImporter, const FCastImportOptions* ImportOptions);
 	static void HandleMaterialImport(FString&& ParentPath, const FString& InFilename, FCastImporter* CastImporter,
 	                                 FCastImportOptions* ImportOptions);
 	static UObject* ExecuteImportProcess(UObject* InParent, FName InName, EObjectFlags Flags, const FString& InFilename,
@@ -65,4 +67,6 @@ private:
 	bool bShowOption;
 	bool bDetectImportTypeOnImport;
 	bool bOperationCanceled;
+	// 源文件和导入选项都没有变化而跳过的资产数
+	int32 NumSkippedAssets;
 };
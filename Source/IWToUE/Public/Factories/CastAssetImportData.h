@@ -9,4 +9,11 @@ class UCastAssetImportData : public UAssetImportData
 public:
 	UPROPERTY()
 	bool bImportAsScene;
+
+	// 上次导入时的选项哈希，和 SourceData 中的文件 MD5 一起判断是否需要重新导入
+	UPROPERTY()
+	uint64 ImportOptionsHash;
+
+	void UpdateCastSource(const FString& Filename, FMD5Hash SourceHash, uint64 OptionsHash);
+	bool IsUpToDate(const FMD5Hash& SourceHash, uint64 OptionsHash) const;
 };
@@ -0,0 +1,13 @@
+﻿#pragma once
+#include "CastMeshImportData.h"
+#include "CastSkeletalMeshImportData.generated.h"
+
+UCLASS(BlueprintType, config=EditorPerProjectUserSettings, AutoExpandCategories=(Options), MinimalAPI)
+class UCastSkeletalMeshImportData : public UCastMeshImportData
+{
+	GENERATED_BODY()
+
+public:
+	static UCastSkeletalMeshImportData* GetImportDataForSkeletalMesh(USkeletalMesh* SkeletalMesh,
+	                                                                 UCastSkeletalMeshImportData* TemplateForCreation);
+};
@@ -6,6 +6,21 @@
 #include "Factories/Factory.h"
 #include "SeAnimAssetFactory.generated.h"
 
+struct FBoneInfo;
+struct FReferenceSkeleton;
+
+// 骨架骨骼名到索引的查找表，名称比较与 FName 一样不区分大小写，重名时取第一个
+struct IWTOUE_API FSeAnimBoneNameMap
+{
+	void Build(const FReferenceSkeleton& RefSkeleton);
+	int32 Find(const FString& BoneName) const;
+	// 每个动画骨骼对应的骨架骨骼索引，骨架中没有的为 INDEX_NONE
+	TArray<int32> Resolve(const TArray<FBoneInfo>& AnimBones) const;
+
+private:
+	TMap<FName, int32> IndexByName;
+};
+
 /**
  * 
  */
@@ -22,11 +37,14 @@ protected:
 
 	FMeshBoneInfo GetBone(const FString& AnimBoneName);
 	int GetBoneIndex(const FString& AnimBoneName);
+	int32 FindBoneIndex(const FString& AnimBoneName) const;
 
 protected:
 	UPROPERTY()
 	class USeAnimOptions* SettingsImporter;
 	TArray<FMeshBoneInfo> Bones;
+	// 每次导入时根据 Bones 重建
+	FSeAnimBoneNameMap BoneNameMap;
 	
 	bool bImport{false};
 	bool bImportAll{false};
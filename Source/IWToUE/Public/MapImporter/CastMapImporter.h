@@ -15,6 +15,7 @@ private:
 	void ImportMapFromJson();
 	void ImportMapFronCord();
 	void ImportAssetFronCord();
+	void ImportAnimationsForSkeleton();
 
 	FReply OnConfirmImport(TSharedRef<SWindow> DialogWindow, TSharedPtr<SEditableTextBox> JsonFilePathBox,
 					   TSharedPtr<SEditableTextBox> ModelFolderPathBox, TSharedPtr<SEditableTextBox> ModelPathBox,
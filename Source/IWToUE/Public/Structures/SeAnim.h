@@ -20,16 +20,22 @@ struct FAnimationBoneModifier
 };
 
 template <class T>
-struct TWraithAnimFrame
+struct TSeAnimTrack
 {
-	// The frame of this animation key
-	uint32 Frame;
-	// The frame value of this key
-	T Value;
+	// The frames of this track's keys, in file order
+	TArray<uint32> Frames;
+	// The key values, Values[i] belongs to Frames[i]
+	TArray<T> Values;
 
-	bool HasFrame(const uint32 FrameToCheck) const
+	int32 Num() const
 	{
-		return Frame == FrameToCheck;
+		return Frames.Num();
+	}
+
+	const T* FindValueAtFrame(const uint32 FrameToCheck) const
+	{
+		const int32 KeyIndex = Frames.Find(FrameToCheck);
+		return KeyIndex == INDEX_NONE ? nullptr : &Values[KeyIndex];
 	}
 };
 
@@ -37,48 +43,31 @@ struct FBoneInfo
 {
 	FString Name;
 	int Index;
-	TArray<TWraithAnimFrame<FVector3f>> BonePositions;
-	TArray<TWraithAnimFrame<FQuat4f>> BoneRotations;
-	TArray<TWraithAnimFrame<FVector3f>> BoneScale;
+	// 默认为文件头的类型，可被 AnimationBoneModifiers 覆盖
+	ESeAnimAnimationType AnimType{ESeAnimAnimationType::SEANIM_ABSOLUTE};
+	TSeAnimTrack<FVector3f> BonePositions;
+	TSeAnimTrack<FQuat4f> BoneRotations;
+	TSeAnimTrack<FVector3f> BoneScale;
 
 	FVector3f GetPositionAtFrame(const uint32 FrameAsked) const
 	{
-		for (const auto& Var : BonePositions)
-		{
-			if (Var.HasFrame(FrameAsked))
-			{
-				return Var.Value;
-			}
-		}
-		return FVector3f(-1, -1, -1);
+		const FVector3f* Value = BonePositions.FindValueAtFrame(FrameAsked);
+		return Value ? *Value : FVector3f(-1, -1, -1);
 	}
 
 	FQuat4f GetRotationAtFrame(const uint32_t FrameAsked) const
 	{
-		for (const auto& Var : BoneRotations)
-		{
-			if (Var.HasFrame(FrameAsked))
-			{
-				return Var.Value;
-			}
-		}
-		return FQuat4f(-1, -1, -1, -1);
+		const FQuat4f* Value = BoneRotations.FindValueAtFrame(FrameAsked);
+		return Value ? *Value : FQuat4f(-1, -1, -1, -1);
 	}
 
 	FVector3f GetScaleAtFrame(const uint32 FrameAsked) const
 	{
-		for (const auto& Var : BoneScale)
-		{
-			if (Var.HasFrame(FrameAsked))
-			{
-				return Var.Value;
-			}
-		}
-		return FVector3f(-1, -1, -1);
+		const FVector3f* Value = BoneScale.FindValueAtFrame(FrameAsked);
+		return Value ? *Value : FVector3f(-1, -1, -1);
 	}
 };
 
-
 struct FAnimHeader
 {
 	char Magic[6];
@@ -118,7 +107,7 @@ struct FSeAnim
 	FAnimHeader Header;
 	TArray<FBoneInfo> BonesInfos;
 	template <typename T>
-	void ParseKeyframeData(FLargeMemoryReader& Reader, TArray<TWraithAnimFrame<T>>& KeyframeArray);
+	void ParseKeyframeData(FLargeMemoryReader& Reader, TSeAnimTrack<T>& Track);
 	static FQuat4f FixRotationAbsolute(FQuat4f QuatRot, FQuat4f InitialRot);
 	static FVector3f FixPositionAbsolute(FVector3f QuatPos, FVector3f InitialPos);
 };
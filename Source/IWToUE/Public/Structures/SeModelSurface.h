@@ -36,15 +36,6 @@ struct FSeModelVertexColor
 	}
 };
 
-struct FSeModelVertex
-{
-	FVector3f Position;
-	FVector3f Normal;
-	FVector2f UV;
-	FSeModelVertexColor Color;
-	TArray<FSeModelWeight> Weights;
-};
-
 struct FGfxFace
 {
 	uint32_t Index[3];
@@ -58,7 +49,13 @@ public:
 	                         bool bUseColors = true, bool bUseWeights = true);
 
 	FString SurfaceName;
-	TArray<FSeModelVertex> Vertexes;
+	// 顶点属性按流存储，与文件中的布局一致，每个流整体读取
+	TArray<FVector3f> Positions;
+	TArray<FVector2f> UVs;
+	TArray<FVector3f> Normals;
+	TArray<FSeModelVertexColor> Colors;
+	/** 每个顶点 MaxSkinInfluence 个权重，顶点 i 的权重从 i * MaxSkinInfluence 开始*/
+	TArray<FSeModelWeight> Weights;
 	TArray<FGfxFace> Faces;
 	TArray<int32> Materials;
 	uint8 UVCount{0};
@@ -72,4 +69,7 @@ public:
 	uint8 MaxSkinInfluence{0};
 
 	TArray<FGfxFace> ParseFaces(FLargeMemoryReader& Reader) const;
+
+private:
+	void ReadWeights(FLargeMemoryReader& Reader);
 };
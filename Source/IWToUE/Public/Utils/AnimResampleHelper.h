@@ -0,0 +1,29 @@
+﻿#pragma once
+
+namespace AnimResampleHelper
+{
+	/**
+	 * @brief 将稀疏关键帧线性插值到 OutValues 的每一帧。
+	 * 第一个关键帧之前和最后一个关键帧之后保持端点值，没有关键帧时不写入。
+	 */
+	void ResampleFloatTrack(TArrayView<const uint32> KeyFrames, TArrayView<const float> KeyValues,
+	                        TArrayView<float> OutValues);
+
+	/**
+	 * @brief 四元数版本，使用 nlerp，并保证相邻关键帧处于同一半球。
+	 */
+	void ResampleQuatTrack(TArrayView<const uint32> KeyFrames, TArrayView<const FVector4f> KeyValues,
+	                       TArrayView<FVector4f> OutValues);
+
+	/**
+	 * @brief FVector3f 版本，逐分量线性插值。
+	 */
+	void ResampleVectorTrack(TArrayView<const uint32> KeyFrames, TArrayView<const FVector3f> KeyValues,
+	                         TArrayView<FVector3f> OutValues);
+
+	/**
+	 * @brief FQuat4f 版本，使用 FQuat4f::Slerp。
+	 */
+	void ResampleRotationTrack(TArrayView<const uint32> KeyFrames, TArrayView<const FQuat4f> KeyValues,
+	                           TArrayView<FQuat4f> OutValues);
+}
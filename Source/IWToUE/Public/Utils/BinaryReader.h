@@ -25,13 +25,21 @@ public:
 template <typename T>
 TArray<T> FBinaryReader::ReadList(FArchive& Ar, uint32_t Count)
 {
+	static_assert(TIsTriviallyCopyable<T>::Value, "ReadList only supports trivially copyable types");
+
+	// 一次读取整个数组，只有需要交换字节序时才逐元素(按分量)处理
 	TArray<T> Arr;
-	T Vec;
-	Arr.Reserve(Count);
-	for (uint32_t x = 0; x < Count; x++)
+	Arr.SetNumUninitialized(Count);
+	if (!Ar.IsByteSwapping())
+	{
+		Ar.Serialize(Arr.GetData(), static_cast<int64>(Count) * sizeof(T));
+	}
+	else
 	{
-		Ar.ByteOrderSerialize(&Vec, sizeof(Vec));;
-		Arr.Push(Vec);
+		for (T& Element : Arr)
+		{
+			Ar << Element;
+		}
 	}
 
 	return Arr;
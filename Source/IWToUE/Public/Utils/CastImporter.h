@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Widgets/CastImportUI.h"
+#include "CastManager/CastAnimation.h"
 #include "CastManager/CastManager.h"
 #include "CastManager/CastModel.h"
 #include "CastManager/CastScene.h"
@@ -10,6 +11,7 @@ class FCastFileTexture;
 struct FCastScene;
 struct FCastSceneInfo;
 class FCastNode;
+struct FMeshDescription;
 
 namespace CastScene
 {
@@ -58,10 +60,23 @@ struct FCastImportOptions
 	bool bImportAnimationNotify;
 	bool bDeleteRootNodeAnim;
 	bool bReverseFace;
+	bool bGenerateLightmapUVs;
+	bool bWeldVertices;
 	ECastAnimImportType AnimImportType;
 	bool bConvertRefPosition;
 	bool bConvertRefAnim;
 	ECastMaterialType MaterialType;
+
+	// 影响导入结果的选项哈希，保存在资产中，用于判断已导入资产是否需要重新导入
+	uint64 GetHash() const;
+};
+
+// 参与蒙皮网格导入的单个网格，以及它在合并后数据中的材质和骨骼偏移
+struct FCastMeshSlice
+{
+	const FCastMeshInfo* Mesh{nullptr};
+	int32 MatIdx{0};
+	int32 BoneOffset{0};
 };
 
 struct FCastMaterial
@@ -87,18 +102,29 @@ public:
 	int32 GetImportType(const FString& InFilename);
 	bool OpenFile(FString Filename);
 	bool GetSceneInfo(FString Filename);
+	void UpdateSceneInfo();
 	bool ImportFile(FString Filename);
 	bool ImportFromFile(FString Filename);
+	// 同一文件只计算一次 MD5
+	const FMD5Hash& GetSourceHash(const FString& Filename);
+	void UpdateImportData(class UCastAssetImportData* ImportData) const;
 	void AnalysisMaterial(const FString& ParentPath, FString MaterialPath, FString TexturePath,
 	                      FString TextureFormat, bool bUseGlobalTexturePath = false);
-	bool AnalysisTexture(FCastTextureInfo& Texture, FString ParentPath, FString TextureLineText, FString TexturePath,
-	                     const FString& ImageFormat);
-
-	bool AnalysisSetting(FCastSettingInfo& Setting, FString SettingLineText);
+	static bool AnalysisTexture(FCastTextureInfo& Texture, const FString& TextureLineText);
+	static bool AnalysisSetting(FCastSettingInfo& Setting, const FString& SettingLineText);
+	// 材质描述文件的解析缓存和材质实例缓存在一次导入(可能包含多个文件)结束后清空
+	void ClearMaterialCaches();
 
 	bool ImportTexture(FCastTextureInfo& Texture, const FString& FilePath, const FString& ParentPath, bool bSRGB);
+	/**
+	 * @brief 批量导入贴图：按工作线程数分块，块内并行解码后在游戏线程创建 UTexture2D 并释放解码数据，最后统一保存一次。
+	 * 成功时填写 TextureObject。
+	 */
+	void ImportTextures(TArrayView<FCastTextureInfo> Textures, const FString& ParentPath);
 	static FString NoIllegalSigns(const FString& InString);
 	UMaterialInterface* CreateMaterialInstance(const FCastMaterialInfo& Material, const UObject* ParentPackage);
+	static uint64 GetMaterialSignature(const FCastMaterialInfo& Material, const FString& ParentMaterialPath,
+	                                   bool bMetallic);
 
 	void ClearAllCaches();
 
@@ -112,12 +138,39 @@ public:
 	                                     bool bIsAutomated, const FString& FullPath,
 	                                     bool& OutOperationCanceled,
 	                                     bool& OutImportAll, const FString& InFilename);
+	static void ApplyImportUI(const UCastImportUI* ImportUI, FCastImportOptions& OutOptions);
 
 	USkeletalMesh* ImportSkeletalMesh(CastScene::FImportSkeletalMeshArgs& ImportSkeletalMeshArgs);
+	/**
+	 * @brief 填充 Points/Faces/Wedges/Influences，各网格写入互不重叠的区间。
+	 * bParallel 为 false 时串行执行，结果与并行完全一致。
+	 */
+	static void FillSkeletalMeshGeometry(FSkeletalMeshImportData& Data, TArrayView<const FCastMeshSlice> Slices,
+	                                     bool bReverseFace, bool bParallel = true);
 	UStaticMesh* ImportStaticMesh(UObject* InParent, const FName InName, EObjectFlags Flags);
 	UAnimSequence* ImportAnim(UObject* InParent, USkeleton* Skeleton);
-
+	/**
+	 * @brief 批量导入同一骨架的多个 cast 动画。
+	 * 骨骼查找表只构建一次，文件在工作线程中并行解析和重采样，只有创建 UAnimSequence 在游戏线程进行。
+	 * 所有文件都使用 Options，不读取单例中上一次导入留下的选项。
+	 */
+	TArray<UAnimSequence*> ImportAnimBatch(const TArray<FString>& Filenames, const FString& PackagePath,
+	                                       USkeleton* Skeleton, const FCastImportOptions& Options);
+
+	/**
+	 * @brief 用模型中的所有网格填充 MeshDescription，每个网格一个多边形组。
+	 * bParallel 为 false 时串行写入顶点属性，结果与并行完全一致。
+	 * @return 模型中最大的 UV 层索引
+	 */
+	static uint32 FillStaticMeshDescription(FMeshDescription& MeshDescription, const FCastModelInfo& Model,
+	                                        bool bParallel = true);
 	void BulidStaticMeshFromModel(UObject* ParentPackage, FCastModelInfo& Model, UStaticMesh* StaticMesh);
+	/**
+	 * @brief 开启后 ImportStaticMesh 只提交 MeshDescription，不立即构建，
+	 * 由 FlushDeferredStaticMeshBuilds 通过 UStaticMesh::BatchBuild 一起并行构建。
+	 */
+	void SetDeferStaticMeshBuilds(bool bDefer);
+	void FlushDeferredStaticMeshBuilds();
 
 	static UObject* CreateAssetOfClass(UClass* AssetClass, FString ParentPackageName, FString ObjectName,
 	                                   bool bAllowReplace = false);
@@ -134,51 +187,96 @@ protected:
 		FIXEDANDCONVERTED,
 	};
 
+	// 每个骨骼对应的曲线，只引用 Animation 中的数据，在 ResampleBoneTracks 中统一重采样
 	struct BoneCurve
 	{
-		TArray<float> PositionX;
-		TArray<float> PositionY;
-		TArray<float> PositionZ;
+		const FCastCurveInfo* PositionX{nullptr};
+		const FCastCurveInfo* PositionY{nullptr};
+		const FCastCurveInfo* PositionZ{nullptr};
 
-		TArray<FVector4> Rotation;
+		const FCastCurveInfo* Rotation{nullptr};
 
-		TArray<float> ScaleX;
-		TArray<float> ScaleY;
-		TArray<float> ScaleZ;
+		const FCastCurveInfo* ScaleX{nullptr};
+		const FCastCurveInfo* ScaleY{nullptr};
+		const FCastCurveInfo* ScaleZ{nullptr};
 
 		ECastAnimImportType AnimMode{ECastAnimImportType::CastAIT_Absolutely};
 	};
 
-	bool ImportAnimation(USkeleton* Skeleton, UAnimSequence* DestSeq, FCastAnimationInfo& Animation);
+	static FString GetTextureAssetPath(const FString& FilePath, const FString& ParentPath);
+	UTexture2D* CreateTextureFromImage(const FString& AssetPath, const FString& FilePath, const struct FImage& Image);
+	UTexture2D* ImportTextureWithFactory(const FString& AssetPath, const FString& FilePath);
+	bool ApplyTextureSettings(UTexture2D* Texture, const FString& TextureType);
+
+	// 材质旁 _images.txt / _settings.txt 的解析结果，解析后只读，可在线程间共享
+	struct FCastMaterialFiles
+	{
+		// 只填写了名称和类型
+		TArray<FCastTextureInfo> Textures;
+		bool bHasSettings{false};
+		FString TechSet;
+		TArray<FCastSettingInfo> Settings;
+	};
+
+	static TSharedRef<const FCastMaterialFiles> ParseMaterialFiles(const FString& TexturesFileName,
+	                                                               const FString& SettingsFileName);
+
+	// 参考骨架查找表，同一骨架的多个动画只构建一次
+	struct FAnimBoneTable
+	{
+		struct FBoneInfo
+		{
+			int32 Index;
+			FTransform RefPose;
+		};
+
+		FString RootName;
+		TMap<FName, FBoneInfo> Bones;
+
+		void Build(const FReferenceSkeleton& RefSkeleton);
+	};
+
+	struct FBoneTrackKeys
+	{
+		FName BoneName;
+		TArray<FVector3f> PositionalKeys;
+		TArray<FQuat4f> RotationalKeys;
+		TArray<FVector3f> ScalingKeys;
+	};
+
+	// 工作线程中重采样完成的动画，不再引用 FCastManager 的数据
+	struct FResampledAnimation
+	{
+		FString Name;
+		float Framerate{30.f};
+		uint32 NumberOfFrames{0};
+		TArray<FBoneTrackKeys> BoneTracks;
+		TArray<FCastNotificationTrackInfo> NotificationTracks;
+	};
+
+	void ResampleAnimation(const FAnimBoneTable& BoneTable, const FCastAnimationInfo& Animation,
+	                       FResampledAnimation& OutAnimation) const;
+	void ApplyResampledAnimation(USkeleton* Skeleton, UAnimSequence* DestSeq, const FResampledAnimation& Animation);
 
-	void InitializeAnimationController(IAnimationDataController& Controller, const FCastAnimationInfo& Animation);
+	void InitializeAnimationController(IAnimationDataController& Controller, float Framerate, uint32 NumberOfFrames);
 	void FinalizeController(IAnimationDataController& Controller, UAnimSequence* DestSeq);
 
-	uint32 CalculateNumberOfFrames(const FCastAnimationInfo& Animation);
-	TMap<FString, BoneCurve> ExtractCurves(USkeleton* Skeleton, const FCastAnimationInfo& Animation);
-	void AssignCurveValues(BoneCurve& BoneCurveInfo, const FCastCurveInfo& Curve);
+	uint32 CalculateNumberOfFrames(const FCastAnimationInfo& Animation) const;
+	TMap<FString, BoneCurve> ExtractCurves(const FAnimBoneTable& BoneTable, const FCastAnimationInfo& Animation) const;
+	void AssignCurveValues(BoneCurve& BoneCurveInfo, const FCastCurveInfo& Curve) const;
 	void AddBoneCurves(IAnimationDataController& Controller, const FReferenceSkeleton& RefSkeleton);
-	void PopulateBoneTracks(IAnimationDataController& Controller, const TMap<FString, BoneCurve>& BoneMap,
-	                        const FReferenceSkeleton& RefSkeleton, uint32 NumberOfFrames);
+	void ResampleBoneTracks(const FAnimBoneTable& BoneTable, const TMap<FString, BoneCurve>& BoneMap,
+	                        uint32 NumberOfFrames, TArray<FBoneTrackKeys>& OutBoneTracks) const;
 
 	void SetPositionalKeys(TArray<FVector3f>& PositionalKeys, const BoneCurve& BoneCurveInfo,
-	                       const FVector& BoneLocation, uint32 NumberOfFrames);
+	                       const FVector& BoneLocation, uint32 NumberOfFrames) const;
 	void SetRotationalKeys(TArray<FQuat4f>& RotationalKeys, const BoneCurve& BoneCurveInfo,
-	                       const FQuat& BoneRotation, const FReferenceSkeleton& RefSkeleton, int32 BoneID,
-	                       uint32 NumberOfFrames);
+	                       const FQuat& BoneRotation, bool bHasRefBone, uint32 NumberOfFrames) const;
 	void SetScalingKeys(TArray<FVector3f>& ScalingKeys, const BoneCurve& BoneCurveInfo, const FVector& BoneScale,
-	                    uint32 NumberOfFrames);
+	                    uint32 NumberOfFrames) const;
 
-	void AddAnimationNotifies(UAnimSequence* DestSeq, const FCastAnimationInfo& Animation, float AnimationRate);
-
-	template <typename T>
-	void ExtendToFrameCount(TArray<T>& Keys, int32 NumberOfFrames);
-	template <typename T>
-	void InterpolateAnimationKeyframes(TArray<T>& BoneCurve, const TArray<uint32>& KeyFrameBuffer,
-	                                   const TArray<FVariant>& KeyValueBuffer);
-	template <typename T>
-	T LerpValue(const uint32& LastKey,
-	            const uint32& CurrentKey, const uint32& EndKey, const T& LastValue, const T& EndValue);
+	void AddAnimationNotifies(UAnimSequence* DestSeq, const TArray<FCastNotificationTrackInfo>& NotificationTracks,
+	                          float AnimationRate);
 
 public:
 	FCastImportOptions* ImportOptions;
@@ -186,6 +284,7 @@ public:
 	FString FileBasePath;
 
 	FMD5Hash Md5Hash;
+	FString HashedFilename;
 
 protected:
 	static TSharedPtr<FCastImporter> StaticInstance;
@@ -194,7 +293,17 @@ protected:
 private:
 	TArray<TWeakObjectPtr<UObject>> CreatedObjects;
 
+	void BuildStaticMeshes(const TArray<UStaticMesh*>& StaticMeshes);
+	void WeldMeshes();
+
 	FCastManager* CastManager{nullptr};
+	bool bDeferStaticMeshBuilds{false};
+	TMap<FString, TSharedRef<const FCastMaterialFiles>> MaterialFileCache;
+	TArray<TWeakObjectPtr<UStaticMesh>> DeferredStaticMeshes;
+	// 父材质和参数完全相同的材质共用一个实例
+	TMap<uint64, TWeakObjectPtr<UMaterialInterface>> MaterialInstanceCache;
+	int32 NumMaterialInstanceRequests{0};
+	int32 NumMaterialInstanceHits{0};
 	TArray<FCastMaterialInfo> ImportedMaterials;
 };
 
@@ -203,50 +312,3 @@ T* FCastImporter::CreateAsset(FString ParentPackageName, FString ObjectName, boo
 {
 	return (T*)CreateAssetOfClass(T::StaticClass(), ParentPackageName, ObjectName, bAllowReplace);
 }
-
-template <typename T>
-void FCastImporter::ExtendToFrameCount(TArray<T>& Keys, int32 NumberOfFrames)
-{
-	T LastKey = Keys.Last();
-	while (Keys.Num() < NumberOfFrames) Keys.Add(LastKey);
-}
-
-template <typename T>
-FORCEINLINE void FCastImporter::InterpolateAnimationKeyframes(TArray<T>& BoneCurve,
-                                                              const TArray<uint32>& KeyFrameBuffer,
-                                                              const TArray<FVariant>& KeyValueBuffer)
-{
-	uint32 CurrentFrame = 0;
-	uint32 LastKeyFrame = 0;
-	T LastKeyValue = T();
-	for (int32 i = 0; i < KeyFrameBuffer.Num(); ++i)
-	{
-		if (i == 0)
-		{
-			BoneCurve.Add(KeyValueBuffer[i].GetValue<T>());
-		}
-		else
-		{
-			while (CurrentFrame <= KeyFrameBuffer[i])
-			{
-				while (!BoneCurve.IsValidIndex(CurrentFrame)) BoneCurve.AddZeroed();
-				BoneCurve[CurrentFrame] = LerpValue(LastKeyFrame,
-				                                    CurrentFrame,
-				                                    KeyFrameBuffer[i],
-				                                    LastKeyValue,
-				                                    KeyValueBuffer[i].GetValue<T>());
-				++CurrentFrame;
-			}
-		}
-		LastKeyFrame = KeyFrameBuffer[i];
-		LastKeyValue = KeyValueBuffer[i].GetValue<T>();
-	}
-}
-
-template <typename T>
-FORCEINLINE T FCastImporter::LerpValue(const uint32& LastKey, const uint32& CurrentKey, const uint32& EndKey,
-                                       const T& LastValue,
-                                       const T& EndValue)
-{
-	return FMath::Lerp(LastValue, EndValue, (float)(CurrentKey - LastKey) / (float)(EndKey - LastKey));
-}
@@ -0,0 +1,13 @@
+﻿#pragma once
+
+struct FCastMeshInfo;
+
+namespace MeshWeldHelper
+{
+	/**
+	 * @brief 合并位置、法线、UV0、颜色(以及蒙皮权重)量化后完全相同的顶点，并重映射 Faces。
+	 * 顶点属性数组会被压缩，被 BlendShape 引用的网格不应调用。
+	 * @return 被合并掉的顶点数
+	 */
+	int32 WeldVertices(FCastMeshInfo& Mesh);
+}
@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include "Engine/TextureDefines.h"
+
+class UTexture2D;
+enum class ECastMaterialType : uint8;
+
+namespace TextureSemanticHelper
+{
+	// 材质创建时关心的贴图用途
+	enum class ETextureRole : uint8
+	{
+		None,
+		Metallic,
+		Skin,
+		Hair,
+		Eye
+	};
+
+	struct FTextureSemantic
+	{
+		TextureCompressionSettings Compression{TC_Default};
+		// 关闭 sRGB
+		bool bLinear{false};
+	};
+
+	/**
+	 * @brief 按 TextureType 查表，比较方式与 FString == 相同(不区分大小写)。
+	 * @return 不在表中时返回 nullptr，保持导入时的默认设置
+	 */
+	const FTextureSemantic* FindSemantic(const FString& TextureType);
+
+	/**
+	 * @brief 把表中的压缩和 sRGB 设置应用到贴图上，调用方负责 PreEditChange/PostEditChange。
+	 */
+	void ApplySemantic(UTexture2D* Texture, const FString& TextureType);
+
+	ETextureRole FindRole(ECastMaterialType MaterialType, const FString& TextureType);
+}
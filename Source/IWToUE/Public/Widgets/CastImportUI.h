@@ -57,6 +57,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Mesh, meta=(ImportType="SkeletalMesh", EditCondition="bImportMesh"))
 	bool bReverseFace{false};
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, config, Category=Mesh,
+		meta=(ImportType="StaticMesh", EditCondition="!bImportAsSkeletal"))
+	bool bGenerateLightmapUVs{true};
+
+	// 合并位置、法线、UV、颜色完全相同的顶点
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, config, Category=Mesh,
+		meta=(ImportType="StaticMesh|SkeletalMesh", EditCondition="bImportMesh"))
+	bool bWeldVertices{false};
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, config, Category=Mesh,
 		meta=(ImportType="SkeletalMesh"))
 	bool bPhysicsAsset{true};